@@ -23,7 +23,7 @@ public class TestGame4 : ModuleRules
 			"Slate"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "PhysicsCore", "Chaos" });
 
 		PublicIncludePaths.AddRange(new string[] {
 			"TestGame4",
@@ -41,6 +41,7 @@ public class TestGame4 : ModuleRules
 			"TestGame4/Variant_OrbitalSalvage",
 			"TestGame4/Variant_OrbitalSalvage/Gameplay",
 			"TestGame4/Variant_OrbitalSalvage/Components",
+			"TestGame4/Variant_OrbitalSalvage/Simulation",
 			"TestGame4/Variant_OrbitalSalvage/UI"
 		});
 
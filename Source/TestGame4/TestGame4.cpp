@@ -1,9 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TestGame4.h"
+#include "TestGame4Stats.h"
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TestGame4, "TestGame4" );
 
 DEFINE_LOG_CATEGORY(LogTestGame4)
- 
\ No newline at end of file
+
+DEFINE_STAT(STAT_OrbitalActorsSpawned);
+DEFINE_STAT(STAT_StationActorsSpawned);
+DEFINE_STAT(STAT_TwinStickActorsSpawned);
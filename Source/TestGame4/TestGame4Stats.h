@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * One stat group per gameplay variant, shown in game with "stat OrbitalSalvage", "stat SpaceStation",
+ * "stat Strategy" and "stat TwinStick". Cycle, counter and memory stats are declared next to the code they
+ * measure; counters bumped from more than one file are declared here.
+ */
+DECLARE_STATS_GROUP(TEXT("Orbital Salvage"), STATGROUP_OrbitalSalvage, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("Space Station"), STATGROUP_SpaceStation, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("Strategy"), STATGROUP_Strategy, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("Twin Stick"), STATGROUP_TwinStick, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_OrbitalActorsSpawned, STATGROUP_OrbitalSalvage, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_StationActorsSpawned, STATGROUP_SpaceStation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors Spawned"), STAT_TwinStickActorsSpawned, STATGROUP_TwinStick, );
+
+/** Times the enclosing scope under a cycle stat and emits an Unreal Insights CPU event with the same name. */
+#define TESTGAME4_SCOPE_CYCLE_COUNTER(Stat) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	SCOPE_CYCLE_COUNTER(Stat)
+
+/**
+ * Moves one owner's share of a memory stat from the bytes it reported last (ReportedBytes) to CurrentBytes,
+ * so the stat stays the sum over every live owner, e.g. one per PIE world. Owners report 0 on teardown.
+ */
+#if STATS
+#define TESTGAME4_REPORT_MEMORY_STAT(Stat, ReportedBytes, CurrentBytes) \
+	do \
+	{ \
+		DEC_MEMORY_STAT_BY(Stat, ReportedBytes); \
+		ReportedBytes = (CurrentBytes); \
+		INC_MEMORY_STAT_BY(Stat, ReportedBytes); \
+	} while (0)
+#else
+#define TESTGAME4_REPORT_MEMORY_STAT(Stat, ReportedBytes, CurrentBytes)
+#endif
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MissionComponent.h"
+#include "OrbitalSimulationRules.h"
 
 UMissionComponent::UMissionComponent()
 {
@@ -34,26 +35,19 @@ FText UMissionComponent::GetObjectiveText() const
 void UMissionComponent::MarkBlackBoxRecovered()
 {
 	bHasRecoveredBlackBox = true;
-
-	if (CurrentStage == EOrbitalMissionStage::RetrieveBlackBox)
-	{
-		CurrentStage = EOrbitalMissionStage::JumpToRuins;
-	}
+	CurrentStage = FOrbitalMissionRules::OnBlackBoxRecovered(CurrentStage);
 }
 
 void UMissionComponent::NotifyEnteredSector(EOrbitalSectorId Sector)
 {
-	if (CurrentStage == EOrbitalMissionStage::JumpToRuins && Sector == EOrbitalSectorId::Ruins)
-	{
-		CurrentStage = EOrbitalMissionStage::ExtractAtBeacon;
-	}
+	CurrentStage = FOrbitalMissionRules::OnEnteredSector(CurrentStage, Sector);
 }
 
 bool UMissionComponent::TryCompleteExtraction(int32& OutReward)
 {
 	OutReward = 0;
 
-	if (CurrentStage != EOrbitalMissionStage::ExtractAtBeacon || !bHasRecoveredBlackBox)
+	if (!FOrbitalMissionRules::CanCompleteExtraction(CurrentStage, bHasRecoveredBlackBox))
 	{
 		return false;
 	}
@@ -4,10 +4,25 @@
 #include "ShipSystemsComponent.h"
 #include "OrbitalGameMode.h"
 #include "OrbitalResourceNode.h"
+#include "OrbitalResourceField.h"
 #include "OrbitalEnemyDrone.h"
+#include "OrbitalDroneSwarm.h"
+#include "OrbitalSectorManager.h"
 #include "OrbitalTypes.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Salvage Mining"), STAT_OrbitalSalvageMining, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Beam Traces"), STAT_OrbitalBeamTraces, STATGROUP_OrbitalSalvage);
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<bool> CVarOrbitalDrawMiningBeam(
+	TEXT("Orbital.DrawMiningBeam"),
+	true,
+	TEXT("Draws the salvage component mining beam as a debug line."));
+#endif
 
 USalvageComponent::USalvageComponent()
 {
@@ -41,11 +56,14 @@ void USalvageComponent::SetMiningActive(bool bActive)
 	if (!bMiningActive)
 	{
 		CurrentTarget = nullptr;
+		InvalidateBeamCache();
 	}
 }
 
 void USalvageComponent::TickMining(float DeltaTime)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSalvageMining);
+
 	if (!ShipSystems)
 	{
 		return;
@@ -58,6 +76,7 @@ void USalvageComponent::TickMining(float DeltaTime)
 	{
 		bMiningActive = false;
 		CurrentTarget = nullptr;
+		InvalidateBeamCache();
 		return;
 	}
 
@@ -70,24 +89,55 @@ void USalvageComponent::TickMining(float DeltaTime)
 	}
 
 	const FVector Start = GetOwner()->GetActorLocation();
-	const FVector End = Start + GetOwner()->GetActorForwardVector() * MiningRange;
+	const FVector Direction = GetOwner()->GetActorForwardVector();
+	const FVector End = Start + Direction * MiningRange;
 
-	FHitResult Hit;
-	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SalvageTrace), false, GetOwner());
-	QueryParams.bTraceComplex = false;
+	// The physics hit comes from an async trace issued on an earlier frame and is reused until the ship
+	// moves or turns past the retrace thresholds.
+	ConsumePendingTrace(World);
+	CachedHitAge += DeltaTime;
+	if (!IsCachedHitUsable(Start, Direction))
+	{
+		RequestTrace(World, Start, Direction);
+	}
 
-	World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, QueryParams);
-	DrawDebugLine(World, Start, End, FColor::Cyan, false, 0.02f, 0, 1.0f);
+#if ENABLE_DRAW_DEBUG
+	if (CVarOrbitalDrawMiningBeam.GetValueOnGameThread())
+	{
+		DrawDebugLine(World, Start, End, FColor::Cyan, false, 0.02f, 0, 1.0f);
+	}
+#endif
+
+	const bool bHasBlockingHit = bHasCachedHit && CachedHit.bBlockingHit;
+
+	AOrbitalGameMode* GM = World->GetAuthGameMode<AOrbitalGameMode>();
+
+	// Swarm drones have no collision, so the beam is tested against them separately and the nearer hit wins.
+	AOrbitalDroneSwarm* DroneSwarm = GM && GM->SectorManager ? GM->SectorManager->GetDroneSwarm() : nullptr;
+	float DroneDistance = 0.0f;
+	const int32 DroneIndex = DroneSwarm ? DroneSwarm->RaycastDrones(Start, End, DroneDistance) : INDEX_NONE;
+	if (DroneIndex != INDEX_NONE && (!bHasBlockingHit || DroneDistance < CachedHit.Distance))
+	{
+		CurrentTarget = DroneSwarm;
+		DroneSwarm->ApplyMiningDamage(DroneIndex, MiningDamagePerSecond * DeltaTime);
+		return;
+	}
 
-	if (!Hit.bBlockingHit || !Hit.GetActor())
+	AActor* HitActor = bHasBlockingHit ? CachedHit.Actor.Get() : nullptr;
+	if (!HitActor || HitActor->IsHidden())
 	{
 		CurrentTarget = nullptr;
 		return;
 	}
 
-	CurrentTarget = Hit.GetActor();
+	CurrentTarget = HitActor;
 
-	if (AOrbitalResourceNode* ResourceNode = Cast<AOrbitalResourceNode>(Hit.GetActor()))
+	AOrbitalResourceNode* ResourceNode = Cast<AOrbitalResourceNode>(HitActor);
+	AOrbitalResourceField* ResourceField = Cast<AOrbitalResourceField>(HitActor);
+	EOrbitalResourceNodeKind FieldNodeKind = EOrbitalResourceNodeKind::Asteroid;
+	const bool bHitFieldNode = ResourceField && ResourceField->GetNodeKindForComponent(CachedHit.Component.Get(), FieldNodeKind) && CachedHit.Item != INDEX_NONE;
+
+	if (ResourceNode || bHitFieldNode)
 	{
 		EOrbitalResourceType ResourceType = EOrbitalResourceType::Ore;
 		float UnitVolume = 1.0f;
@@ -95,17 +145,26 @@ void USalvageComponent::TickMining(float DeltaTime)
 		bool bRecoveredBlackBox = false;
 
 		const float Requested = BaseMiningRatePerSecond * ShipSystems->GetMiningYieldMultiplier() * DeltaTime;
-		const float ExtractedUnits = ResourceNode->ExtractResource(Requested, ResourceType, UnitVolume, UnitCreditValue, bRecoveredBlackBox);
+		const float UnitsBefore = ResourceNode ? ResourceNode->ResourceUnitsRemaining : ResourceField->GetUnitsRemaining(FieldNodeKind, CachedHit.Item);
+		const float ExtractedUnits = ResourceNode
+			? ResourceNode->ExtractResource(Requested, ResourceType, UnitVolume, UnitCreditValue, bRecoveredBlackBox)
+			: ResourceField->ExtractResource(FieldNodeKind, CachedHit.Item, Requested, ResourceType, UnitVolume, UnitCreditValue, bRecoveredBlackBox);
 		if (ExtractedUnits > 0.0f)
 		{
 			ShipSystems->AddCargo(ResourceType, ExtractedUnits, UnitVolume, UnitCreditValue);
 		}
 
+		// A depleted node is gone (and a field may have swapped another node into its index), so trace again.
+		if (ExtractedUnits >= UnitsBefore - KINDA_SMALL_NUMBER)
+		{
+			InvalidateBeamCache();
+		}
+
 		if (bRecoveredBlackBox)
 		{
 			ShipSystems->AddCargo(EOrbitalResourceType::BlackBox, 1.0f, 8.0f, 0);
 
-			if (AOrbitalGameMode* GM = World->GetAuthGameMode<AOrbitalGameMode>())
+			if (GM)
 			{
 				GM->HandleBlackBoxRecovered();
 			}
@@ -113,9 +172,85 @@ void USalvageComponent::TickMining(float DeltaTime)
 		return;
 	}
 
-	if (AOrbitalEnemyDrone* EnemyDrone = Cast<AOrbitalEnemyDrone>(Hit.GetActor()))
+	if (AOrbitalEnemyDrone* EnemyDrone = Cast<AOrbitalEnemyDrone>(HitActor))
 	{
 		EnemyDrone->ApplyMiningDamage(MiningDamagePerSecond * DeltaTime);
 	}
 }
 
+void USalvageComponent::ConsumePendingTrace(UWorld* World)
+{
+	if (!PendingTrace.IsValid())
+	{
+		return;
+	}
+
+	FTraceDatum TraceDatum;
+	if (!World->QueryTraceData(PendingTrace, TraceDatum))
+	{
+		// Not ready yet, or the handle expired; drop an expired one so a fresh trace can be issued.
+		if (!World->IsTraceHandleValid(PendingTrace, false))
+		{
+			PendingTrace = FTraceHandle();
+		}
+		return;
+	}
+
+	PendingTrace = FTraceHandle();
+
+	CachedHit = FBeamHit();
+	if (const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits))
+	{
+		CachedHit.Actor = Hit->GetActor();
+		CachedHit.Component = Hit->GetComponent();
+		CachedHit.Item = Hit->Item;
+		CachedHit.Distance = Hit->Distance;
+		CachedHit.bBlockingHit = true;
+	}
+
+	bHasCachedHit = true;
+	CachedHitAge = 0.0f;
+	CachedTraceStart = PendingTraceStart;
+	CachedTraceDirection = PendingTraceDirection;
+}
+
+void USalvageComponent::RequestTrace(UWorld* World, const FVector& Start, const FVector& Direction)
+{
+	if (PendingTrace.IsValid())
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SalvageTrace), false, GetOwner());
+	QueryParams.bTraceComplex = false;
+
+	INC_DWORD_STAT(STAT_OrbitalBeamTraces);
+	PendingTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + Direction * MiningRange, ECC_Visibility, QueryParams);
+	PendingTraceStart = Start;
+	PendingTraceDirection = Direction;
+}
+
+bool USalvageComponent::IsCachedHitUsable(const FVector& Start, const FVector& Direction) const
+{
+	if (!bHasCachedHit || CachedHitAge > MaxCachedHitAge)
+	{
+		return false;
+	}
+
+	// Pooled actors are hidden rather than destroyed, so a hidden target counts as gone.
+	if (CachedHit.bBlockingHit && (!CachedHit.Actor.IsValid() || CachedHit.Actor->IsHidden()))
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(Start, CachedTraceStart) <= FMath::Square(RetraceDistance)
+		&& FVector::DotProduct(Direction, CachedTraceDirection) >= FMath::Cos(FMath::DegreesToRadians(RetraceAngleDegrees));
+}
+
+void USalvageComponent::InvalidateBeamCache()
+{
+	bHasCachedHit = false;
+	CachedHit = FBeamHit();
+	PendingTrace = FTraceHandle();
+}
+
@@ -4,11 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "WorldCollision.h"
 #include "SalvageComponent.generated.h"
 
 class UShipSystemsComponent;
 class AOrbitalResourceNode;
 class AOrbitalEnemyDrone;
+class UPrimitiveComponent;
 
 /**
  * Handles mining/salvage laser interactions for the player's ship.
@@ -42,6 +44,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Salvage")
 	float MiningDamagePerSecond = 20.0f;
 
+	/** Ship movement that invalidates the cached beam hit and queues a new async trace. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Salvage|Trace")
+	float RetraceDistance = 20.0f;
+
+	/** Ship rotation, in degrees, that invalidates the cached beam hit. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Salvage|Trace")
+	float RetraceAngleDegrees = 0.5f;
+
+	/** Age after which a cached beam hit is re-validated even if the ship is still, so moving obstacles are noticed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Salvage|Trace")
+	float MaxCachedHitAge = 0.1f;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Salvage")
 	bool bMiningActive = false;
 
@@ -58,6 +72,29 @@ private:
 	UPROPERTY()
 	AActor* CurrentTarget = nullptr;
 
+	struct FBeamHit
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		int32 Item = INDEX_NONE;
+		float Distance = 0.0f;
+		bool bBlockingHit = false;
+	};
+
+	FBeamHit CachedHit;
+	bool bHasCachedHit = false;
+	float CachedHitAge = 0.0f;
+	FVector CachedTraceStart = FVector::ZeroVector;
+	FVector CachedTraceDirection = FVector::ForwardVector;
+
+	FTraceHandle PendingTrace;
+	FVector PendingTraceStart = FVector::ZeroVector;
+	FVector PendingTraceDirection = FVector::ForwardVector;
+
 	void TickMining(float DeltaTime);
+	void ConsumePendingTrace(UWorld* World);
+	void RequestTrace(UWorld* World, const FVector& Start, const FVector& Direction);
+	bool IsCachedHitUsable(const FVector& Start, const FVector& Direction) const;
+	void InvalidateBeamCache();
 };
 
@@ -1,10 +1,17 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ShipSystemsComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UShipSystemsComponent::UShipSystemsComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
+
+	for (int32& Level : UpgradeLevels)
+	{
+		Level = 0;
+	}
 }
 
 void UShipSystemsComponent::BeginPlay()
@@ -15,40 +22,73 @@ void UShipSystemsComponent::BeginPlay()
 	Fuel = MaxFuel;
 	CurrentPower = MaxPower;
 	Heat = 0.0f;
+
+	Cargo.Reset();
 	CargoUsed = 0.0f;
 
-	UpgradeLevels.Add(EOrbitalUpgradeType::Reactor, 0);
-	UpgradeLevels.Add(EOrbitalUpgradeType::CargoPod, 0);
-	UpgradeLevels.Add(EOrbitalUpgradeType::MiningLaser, 0);
+	for (int32& Level : UpgradeLevels)
+	{
+		Level = 0;
+	}
+	UpdateUpgradeMultipliers();
+
+	SettleTime = GetSystemsTime();
+	ScheduleNextThreshold();
 }
 
-void UShipSystemsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UShipSystemsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	CurrentPower = FMath::Clamp(CurrentPower + PassivePowerRegenPerSecond * DeltaTime, 0.0f, MaxPower);
-	CurrentPower = FMath::Clamp(CurrentPower - PassivePowerDrainPerSecond * DeltaTime, 0.0f, MaxPower);
-	Heat = FMath::Clamp(Heat - HeatDissipationPerSecond * DeltaTime, 0.0f, MaxHeat * 2.0f);
-
-	if (Heat > MaxHeat)
+	if (UWorld* World = GetWorld())
 	{
-		ApplyHullDamage(OverheatHullDamagePerSecond * DeltaTime);
+		World->GetTimerManager().ClearTimer(ThresholdTimer);
 	}
+	ScheduledThresholdTime = TNumericLimits<double>::Max();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float UShipSystemsComponent::GetHull() const
+{
+	return MakeVitals().EvaluateHull(GetElapsedSeconds());
+}
+
+float UShipSystemsComponent::GetCurrentPower() const
+{
+	return MakeVitals().EvaluatePower(GetElapsedSeconds());
+}
+
+float UShipSystemsComponent::GetHeat() const
+{
+	return MakeVitals().EvaluateHeat(GetElapsedSeconds());
+}
+
+void UShipSystemsComponent::SettleSystems()
+{
+	Settle();
+	ScheduleNextThreshold();
 }
 
 void UShipSystemsComponent::AddHeat(float Amount)
 {
+	Settle();
+	const uint8 OldFlags = MakeVitals().GetThresholdFlags();
+
 	Heat = FMath::Clamp(Heat + Amount, 0.0f, MaxHeat * 2.0f);
+
+	CommitChange(OldFlags);
 }
 
 bool UShipSystemsComponent::ConsumePower(float Amount)
 {
+	Settle();
 	if (CurrentPower < Amount)
 	{
 		return false;
 	}
 
+	const uint8 OldFlags = MakeVitals().GetThresholdFlags();
 	CurrentPower -= Amount;
+	CommitChange(OldFlags);
 	return true;
 }
 
@@ -65,12 +105,22 @@ bool UShipSystemsComponent::ConsumeFuel(float Amount)
 
 void UShipSystemsComponent::ApplyHullDamage(float Amount)
 {
+	Settle();
+	const uint8 OldFlags = MakeVitals().GetThresholdFlags();
+
 	Hull = FMath::Max(0.0f, Hull - Amount);
+
+	CommitChange(OldFlags);
 }
 
 void UShipSystemsComponent::RepairHull(float Amount)
 {
+	Settle();
+	const uint8 OldFlags = MakeVitals().GetThresholdFlags();
+
 	Hull = FMath::Clamp(Hull + Amount, 0.0f, MaxHull);
+
+	CommitChange(OldFlags);
 }
 
 void UShipSystemsComponent::Refuel(float Amount)
@@ -80,93 +130,36 @@ void UShipSystemsComponent::Refuel(float Amount)
 
 float UShipSystemsComponent::AddCargo(EOrbitalResourceType ResourceType, float Units, float UnitVolume, int32 UnitCreditValue)
 {
-	if (Units <= 0.0f || UnitVolume <= 0.0f)
-	{
-		return 0.0f;
-	}
-
-	const float FreeVolume = FMath::Max(0.0f, CargoCapacity - CargoUsed);
-	const float MaxUnitsByVolume = FreeVolume / UnitVolume;
-	const float AddedUnits = FMath::Clamp(Units, 0.0f, MaxUnitsByVolume);
-
-	if (AddedUnits <= 0.0f)
-	{
-		return 0.0f;
-	}
-
-	CargoUsed += AddedUnits * UnitVolume;
-	CargoUsed = FMath::Min(CargoUsed, CargoCapacity);
-
-	float& CurrentUnits = CargoUnits.FindOrAdd(ResourceType);
-	CurrentUnits += AddedUnits;
-
-	CargoUnitPrices.Add(ResourceType, UnitCreditValue);
+	const float AddedUnits = Cargo.Add(ResourceType, Units, UnitVolume, UnitCreditValue, CargoCapacity);
+	CargoUsed = Cargo.Used;
 	return AddedUnits;
 }
 
 float UShipSystemsComponent::RemoveCargo(EOrbitalResourceType ResourceType, float UnitsToRemove)
 {
-	float* FoundUnits = CargoUnits.Find(ResourceType);
-	if (!FoundUnits || UnitsToRemove <= 0.0f)
-	{
-		return 0.0f;
-	}
-
-	const float RemovedUnits = FMath::Min(*FoundUnits, UnitsToRemove);
-	*FoundUnits -= RemovedUnits;
-	if (*FoundUnits <= KINDA_SMALL_NUMBER)
-	{
-		CargoUnits.Remove(ResourceType);
-	}
-
-	const float VolumePerUnit = GetCargoVolumeForType(ResourceType);
-	CargoUsed = FMath::Max(0.0f, CargoUsed - RemovedUnits * VolumePerUnit);
+	const float RemovedUnits = Cargo.Remove(ResourceType, UnitsToRemove);
+	CargoUsed = Cargo.Used;
 	return RemovedUnits;
 }
 
 float UShipSystemsComponent::GetCargoUnits(EOrbitalResourceType ResourceType) const
 {
-	const float* FoundUnits = CargoUnits.Find(ResourceType);
-	return FoundUnits ? *FoundUnits : 0.0f;
+	return Cargo.GetUnits(ResourceType);
 }
 
 int32 UShipSystemsComponent::SellAllCargo()
 {
-	int32 TotalRevenue = 0;
-
-	for (const TPair<EOrbitalResourceType, float>& Entry : CargoUnits)
-	{
-		const int32 UnitPrice = CargoUnitPrices.FindRef(Entry.Key);
-		const int32 UnitsRounded = FMath::FloorToInt(Entry.Value);
-		TotalRevenue += UnitsRounded * UnitPrice;
-	}
+	const int32 TotalRevenue = Cargo.SellAll();
 
 	Credits += TotalRevenue;
-	CargoUnits.Empty();
-	CargoUsed = 0.0f;
+	CargoUsed = Cargo.Used;
 
 	return TotalRevenue;
 }
 
 int32 UShipSystemsComponent::GetUpgradeCost(EOrbitalUpgradeType UpgradeType) const
 {
-	const int32 Level = UpgradeLevels.FindRef(UpgradeType);
-	const int32 BaseCost = [&]()
-	{
-		switch (UpgradeType)
-		{
-		case EOrbitalUpgradeType::Reactor:
-			return 1300;
-		case EOrbitalUpgradeType::CargoPod:
-			return 1000;
-		case EOrbitalUpgradeType::MiningLaser:
-			return 1200;
-		default:
-			return 1200;
-		}
-	}();
-
-	return BaseCost + (Level * 800);
+	return FOrbitalUpgradeRules::GetCost(UpgradeType, GetUpgradeLevel(UpgradeType));
 }
 
 bool UShipSystemsComponent::PurchaseUpgrade(EOrbitalUpgradeType UpgradeType)
@@ -177,8 +170,8 @@ bool UShipSystemsComponent::PurchaseUpgrade(EOrbitalUpgradeType UpgradeType)
 		return false;
 	}
 
-	int32& Level = UpgradeLevels.FindOrAdd(UpgradeType);
-	if (Level >= 3)
+	int32& Level = UpgradeLevels[static_cast<int32>(UpgradeType)];
+	if (Level >= FOrbitalUpgradeRules::MaxLevel)
 	{
 		return false;
 	}
@@ -186,51 +179,155 @@ bool UShipSystemsComponent::PurchaseUpgrade(EOrbitalUpgradeType UpgradeType)
 	Credits -= Cost;
 	++Level;
 
-	switch (UpgradeType)
+	// Limits and rates are about to change, so fold in everything accrued under the old ones first.
+	Settle();
+	FOrbitalShipVitals Vitals = MakeVitals();
+	const uint8 OldFlags = Vitals.GetThresholdFlags();
+
+	FOrbitalUpgradeRules::ApplyUpgrade(UpgradeType, Vitals, CargoCapacity);
+	StoreVitals(Vitals);
+
+	UpdateUpgradeMultipliers();
+	CommitChange(OldFlags);
+	return true;
+}
+
+void UShipSystemsComponent::UpdateUpgradeMultipliers()
+{
+	MiningYieldMultiplier = FOrbitalUpgradeRules::GetMiningYieldMultiplier(GetUpgradeLevel(EOrbitalUpgradeType::MiningLaser));
+	MiningHeatMultiplier = FOrbitalUpgradeRules::GetMiningHeatMultiplier(GetUpgradeLevel(EOrbitalUpgradeType::Reactor));
+}
+
+double UShipSystemsComponent::GetSystemsTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : SettleTime;
+}
+
+float UShipSystemsComponent::GetElapsedSeconds() const
+{
+	return FMath::Max(0.0f, static_cast<float>(GetSystemsTime() - SettleTime));
+}
+
+FOrbitalShipVitals UShipSystemsComponent::MakeVitals() const
+{
+	FOrbitalShipVitals Vitals;
+	Vitals.Hull = Hull;
+	Vitals.Power = CurrentPower;
+	Vitals.MaxPower = MaxPower;
+	Vitals.PowerRegenPerSecond = PassivePowerRegenPerSecond;
+	Vitals.PowerDrainPerSecond = PassivePowerDrainPerSecond;
+	Vitals.Heat = Heat;
+	Vitals.MaxHeat = MaxHeat;
+	Vitals.HeatDissipationPerSecond = HeatDissipationPerSecond;
+	Vitals.OverheatHullDamagePerSecond = OverheatHullDamagePerSecond;
+	return Vitals;
+}
+
+void UShipSystemsComponent::StoreVitals(const FOrbitalShipVitals& Vitals)
+{
+	Hull = Vitals.Hull;
+	CurrentPower = Vitals.Power;
+	MaxPower = Vitals.MaxPower;
+	PassivePowerRegenPerSecond = Vitals.PowerRegenPerSecond;
+	PassivePowerDrainPerSecond = Vitals.PowerDrainPerSecond;
+	Heat = Vitals.Heat;
+	MaxHeat = Vitals.MaxHeat;
+	HeatDissipationPerSecond = Vitals.HeatDissipationPerSecond;
+	OverheatHullDamagePerSecond = Vitals.OverheatHullDamagePerSecond;
+}
+
+void UShipSystemsComponent::Settle()
+{
+	const double Now = GetSystemsTime();
+	const float ElapsedSeconds = static_cast<float>(Now - SettleTime);
+	SettleTime = Now;
+
+	if (ElapsedSeconds <= 0.0f)
 	{
-	case EOrbitalUpgradeType::Reactor:
-		MaxPower += 20.0f;
-		PassivePowerRegenPerSecond += 4.0f;
-		CurrentPower = MaxPower;
-		break;
-	case EOrbitalUpgradeType::CargoPod:
-		CargoCapacity += 70.0f;
-		break;
-	case EOrbitalUpgradeType::MiningLaser:
-		MaxHeat += 12.0f;
-		break;
-	default:
-		break;
+		return;
 	}
 
-	return true;
+	FOrbitalShipVitals Vitals = MakeVitals();
+	const uint8 OldFlags = Vitals.GetThresholdFlags();
+
+	Vitals.Advance(ElapsedSeconds);
+	StoreVitals(Vitals);
+
+	BroadcastThresholdChanges(OldFlags);
+}
+
+void UShipSystemsComponent::CommitChange(uint8 OldFlags)
+{
+	BroadcastThresholdChanges(OldFlags);
+	ScheduleNextThreshold();
 }
 
-float UShipSystemsComponent::GetMiningYieldMultiplier() const
+void UShipSystemsComponent::ScheduleNextThreshold()
 {
-	const int32 LaserLevel = UpgradeLevels.FindRef(EOrbitalUpgradeType::MiningLaser);
-	return 1.0f + (LaserLevel * 0.35f);
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const float Delay = MakeVitals().GetSecondsToNextThreshold();
+	if (Delay <= 0.0f)
+	{
+		return;
+	}
+
+	// Spending power or adding heat pushes the next crossing later, and a timer that fires early just settles and
+	// re-arms, so the timer only moves when the crossing comes sooner than the one it is already armed for.
+	const double ThresholdTime = GetSystemsTime() + Delay;
+	if (ThresholdTime >= ScheduledThresholdTime)
+	{
+		return;
+	}
+
+	ScheduledThresholdTime = ThresholdTime;
+	World->GetTimerManager().SetTimer(ThresholdTimer, this, &UShipSystemsComponent::OnThresholdTimer, Delay, false);
 }
 
-float UShipSystemsComponent::GetMiningHeatMultiplier() const
+void UShipSystemsComponent::OnThresholdTimer()
 {
-	const int32 ReactorLevel = UpgradeLevels.FindRef(EOrbitalUpgradeType::Reactor);
-	return FMath::Max(0.45f, 1.0f - (ReactorLevel * 0.12f));
+	ScheduledThresholdTime = TNumericLimits<double>::Max();
+	SettleSystems();
 }
 
-float UShipSystemsComponent::GetCargoVolumeForType(EOrbitalResourceType ResourceType) const
+void UShipSystemsComponent::BroadcastThresholdChanges(uint8 OldFlags)
 {
-	switch (ResourceType)
+	const uint8 NewFlags = MakeVitals().GetThresholdFlags();
+	const uint8 Entered = NewFlags & ~OldFlags;
+	const uint8 Left = OldFlags & ~NewFlags;
+
+	if ((Entered | Left) == 0 || !OnThresholdReached.IsBound())
+	{
+		return;
+	}
+
+	if (Entered & FOrbitalShipVitals::PowerFull)
+	{
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::PowerFull);
+	}
+	if (Entered & FOrbitalShipVitals::PowerDepleted)
+	{
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::PowerDepleted);
+	}
+	if (Entered & FOrbitalShipVitals::Overheated)
+	{
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::OverheatStarted);
+	}
+	if (Left & FOrbitalShipVitals::Overheated)
+	{
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::OverheatEnded);
+	}
+	if (Entered & FOrbitalShipVitals::HeatCleared)
+	{
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::HeatCleared);
+	}
+	if (Entered & FOrbitalShipVitals::HullDestroyed)
 	{
-	case EOrbitalResourceType::Ore:
-		return 1.5f;
-	case EOrbitalResourceType::Salvage:
-		return 1.0f;
-	case EOrbitalResourceType::FuelCell:
-		return 2.0f;
-	case EOrbitalResourceType::BlackBox:
-		return 8.0f;
-	default:
-		return 1.0f;
+		OnThresholdReached.Broadcast(EOrbitalShipThreshold::HullDestroyed);
 	}
 }
@@ -5,11 +5,20 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "OrbitalTypes.h"
+#include "OrbitalSimulationRules.h"
 #include "ShipSystemsComponent.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnShipThresholdReached, EOrbitalShipThreshold, Threshold);
+
 /**
  * Core ship simulation for the Orbital Salvage mode.
  * Tracks hull, power, heat, fuel, cargo and credits.
+ *
+ * Thin wrapper over the plain simulation rules in OrbitalSimulationRules.h.
+ * Power regen, heat dissipation and overheat damage are not ticked. Hull, CurrentPower and Heat hold the
+ * values at the last settle time and the getters evaluate them in closed form from there; a single timer is
+ * armed for the next threshold crossing (power full or empty, overheat end, heat zero, hull destroyed), so an
+ * idle ship costs nothing per frame.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class UShipSystemsComponent : public UActorComponent
@@ -20,13 +29,14 @@ public:
 	UShipSystemsComponent();
 
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Hull
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Hull")
 	float MaxHull = 100.0f;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Hull")
+	/** Hull at the last settle; Blueprints read the current value through GetHull(). */
+	UPROPERTY(VisibleAnywhere, BlueprintGetter=GetHull, Category="Ship|Hull")
 	float Hull = 100.0f;
 
 	// Fuel
@@ -40,7 +50,8 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Power")
 	float MaxPower = 120.0f;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Power")
+	/** Power at the last settle; Blueprints read the current value through GetCurrentPower(). */
+	UPROPERTY(VisibleAnywhere, BlueprintGetter=GetCurrentPower, Category="Ship|Power")
 	float CurrentPower = 120.0f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Power")
@@ -53,7 +64,8 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Heat")
 	float MaxHeat = 100.0f;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Heat")
+	/** Heat at the last settle; Blueprints read the current value through GetHeat(). */
+	UPROPERTY(VisibleAnywhere, BlueprintGetter=GetHeat, Category="Ship|Heat")
 	float Heat = 0.0f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Heat")
@@ -69,20 +81,33 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Cargo")
 	float CargoUsed = 0.0f;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Cargo")
-	TMap<EOrbitalResourceType, float> CargoUnits;
-
 	// Economy
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Ship|Economy")
 	int32 Credits = 2500;
 
-	// Upgrade Levels
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ship|Upgrade")
-	TMap<EOrbitalUpgradeType, int32> UpgradeLevels;
+	/** Broadcast when the ship crosses one of the power, heat or hull thresholds. */
+	UPROPERTY(BlueprintAssignable, Category="Ship")
+	FOnShipThresholdReached OnThresholdReached;
 
 public:
 	UFUNCTION(BlueprintPure, Category="Ship")
-	bool IsAlive() const { return Hull > 0.0f; }
+	bool IsAlive() const { return GetHull() > 0.0f; }
+
+	UFUNCTION(BlueprintPure, Category="Ship|Hull")
+	float GetHull() const;
+
+	UFUNCTION(BlueprintPure, Category="Ship|Power")
+	float GetCurrentPower() const;
+
+	UFUNCTION(BlueprintPure, Category="Ship|Heat")
+	float GetHeat() const;
+
+	UFUNCTION(BlueprintPure, Category="Ship|Heat")
+	bool IsOverheated() const { return GetHeat() > MaxHeat; }
+
+	/** Folds elapsed regen and dissipation into the stored values and re-arms the threshold timer. Call after changing rates or limits at runtime. */
+	UFUNCTION(BlueprintCallable, Category="Ship")
+	void SettleSystems();
 
 	UFUNCTION(BlueprintCallable, Category="Ship")
 	void AddHeat(float Amount);
@@ -114,6 +139,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Ship|Cargo")
 	int32 SellAllCargo();
 
+	UFUNCTION(BlueprintPure, Category="Ship|Upgrade")
+	int32 GetUpgradeLevel(EOrbitalUpgradeType UpgradeType) const { return UpgradeLevels[static_cast<int32>(UpgradeType)]; }
+
 	UFUNCTION(BlueprintPure, Category="Ship|Economy")
 	int32 GetUpgradeCost(EOrbitalUpgradeType UpgradeType) const;
 
@@ -121,14 +149,42 @@ public:
 	bool PurchaseUpgrade(EOrbitalUpgradeType UpgradeType);
 
 	UFUNCTION(BlueprintPure, Category="Ship|Upgrade")
-	float GetMiningYieldMultiplier() const;
+	float GetMiningYieldMultiplier() const { return MiningYieldMultiplier; }
 
 	UFUNCTION(BlueprintPure, Category="Ship|Upgrade")
-	float GetMiningHeatMultiplier() const;
+	float GetMiningHeatMultiplier() const { return MiningHeatMultiplier; }
 
 private:
-	TMap<EOrbitalResourceType, int32> CargoUnitPrices;
+	FOrbitalCargoLedger Cargo;
 
-	float GetCargoVolumeForType(EOrbitalResourceType ResourceType) const;
-};
+	TStaticArray<int32, FOrbitalUpgradeRules::NumUpgradeTypes> UpgradeLevels;
+
+	// Derived from UpgradeLevels; refreshed only when an upgrade is bought.
+	float MiningYieldMultiplier = 1.0f;
+	float MiningHeatMultiplier = 1.0f;
+
+	/** World time Hull, CurrentPower and Heat were last brought up to date. */
+	double SettleTime = 0.0;
+
+	FTimerHandle ThresholdTimer;
 
+	/** World time ThresholdTimer is armed for, or the largest double when it is not armed. */
+	double ScheduledThresholdTime = TNumericLimits<double>::Max();
+
+	double GetSystemsTime() const;
+	float GetElapsedSeconds() const;
+
+	/** Copies the power, heat and hull properties into the simulation struct and back. */
+	FOrbitalShipVitals MakeVitals() const;
+	void StoreVitals(const FOrbitalShipVitals& Vitals);
+
+	/** Brings Hull, CurrentPower and Heat up to the current time without re-arming the timer. */
+	void Settle();
+	void CommitChange(uint8 OldFlags);
+	/** Arms the timer for the next threshold crossing, unless one is already armed to fire no later. */
+	void ScheduleNextThreshold();
+	void OnThresholdTimer();
+
+	void BroadcastThresholdChanges(uint8 OldFlags);
+	void UpdateUpgradeMultipliers();
+};
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalActorPoolSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pool Acquire"), STAT_OrbitalPoolAcquire, STATGROUP_OrbitalSalvage);
+DECLARE_CYCLE_STAT(TEXT("Pool Release"), STAT_OrbitalPoolRelease, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Reuses"), STAT_OrbitalPoolReuses, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Actors"), STAT_OrbitalPooledActors, STATGROUP_OrbitalSalvage);
+
+void UOrbitalActorPoolSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_OrbitalPooledActors, PooledActors.Num());
+
+	Buckets.Empty();
+	PooledActors.Empty();
+	PoolHits = 0;
+	PoolMisses = 0;
+
+	Super::Deinitialize();
+}
+
+AActor* UOrbitalActorPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FVector& Location, const FRotator& Rotation)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalPoolAcquire);
+
+	UWorld* World = GetWorld();
+	if (!World || !ActorClass)
+	{
+		return nullptr;
+	}
+
+	if (FOrbitalActorPoolBucket* Bucket = Buckets.Find(ActorClass.Get()))
+	{
+		while (Bucket->InactiveActors.Num() > 0)
+		{
+			AActor* Actor = Bucket->InactiveActors.Pop(EAllowShrinking::No);
+			PooledActors.Remove(Actor);
+			DEC_DWORD_STAT(STAT_OrbitalPooledActors);
+
+			if (!IsValid(Actor))
+			{
+				continue;
+			}
+
+			++PoolHits;
+			INC_DWORD_STAT(STAT_OrbitalPoolReuses);
+
+			Actor->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+			Actor->SetActorHiddenInGame(false);
+			Actor->SetActorEnableCollision(true);
+			if (Actor->PrimaryActorTick.bCanEverTick)
+			{
+				Actor->SetActorTickEnabled(true);
+			}
+
+			if (IOrbitalPooledActor* Pooled = Cast<IOrbitalPooledActor>(Actor))
+			{
+				Pooled->OnAcquiredFromPool();
+			}
+
+			return Actor;
+		}
+	}
+
+	++PoolMisses;
+	INC_DWORD_STAT(STAT_OrbitalActorsSpawned);
+	return World->SpawnActor<AActor>(ActorClass, Location, Rotation);
+}
+
+void UOrbitalActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalPoolRelease);
+
+	if (!IsValid(Actor) || PooledActors.Contains(Actor))
+	{
+		return;
+	}
+
+	if (IOrbitalPooledActor* Pooled = Cast<IOrbitalPooledActor>(Actor))
+	{
+		Pooled->OnReturnedToPool();
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	Buckets.FindOrAdd(Actor->GetClass()).InactiveActors.Add(Actor);
+	PooledActors.Add(Actor);
+	INC_DWORD_STAT(STAT_OrbitalPooledActors);
+}
+
+int32 UOrbitalActorPoolSubsystem::GetNumPooled(TSubclassOf<AActor> ActorClass) const
+{
+	const FOrbitalActorPoolBucket* Bucket = Buckets.Find(ActorClass.Get());
+	return Bucket ? Bucket->InactiveActors.Num() : 0;
+}
+
+void UOrbitalActorPoolSubsystem::ResetPoolCounters()
+{
+	PoolHits = 0;
+	PoolMisses = 0;
+}
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OrbitalActorPoolSubsystem.generated.h"
+
+UINTERFACE(MinimalAPI, meta=(CannotImplementInterfaceInBlueprint))
+class UOrbitalPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reset hooks for actors recycled by UOrbitalActorPoolSubsystem.
+ * BeginPlay only runs for freshly spawned actors; reused ones get OnAcquiredFromPool instead.
+ */
+class IOrbitalPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Called after a pooled actor has been moved into place and made visible again. */
+	virtual void OnAcquiredFromPool() {}
+
+	/** Called before the actor is hidden and parked in the pool. */
+	virtual void OnReturnedToPool() {}
+};
+
+USTRUCT()
+struct FOrbitalActorPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> InactiveActors;
+};
+
+/**
+ * Per-class pool of Orbital sector actors (stations, gates, resource nodes, drones).
+ * Released actors are hidden with collision and tick disabled instead of destroyed, so jumping
+ * back and forth between sectors reuses the same actors rather than churning GC and the physics scene.
+ */
+UCLASS()
+class UOrbitalActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns an inactive actor of exactly ActorClass moved to Location, spawning one on a pool miss. */
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	template<typename T>
+	T* Acquire(const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator)
+	{
+		return Cast<T>(AcquireActor(T::StaticClass(), Location, Rotation));
+	}
+
+	/** Deactivates Actor and parks it for reuse. Releasing an actor that is already pooled is a no-op. */
+	void ReleaseActor(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category="Orbital|Pool")
+	int32 GetPoolHits() const { return PoolHits; }
+
+	UFUNCTION(BlueprintPure, Category="Orbital|Pool")
+	int32 GetPoolMisses() const { return PoolMisses; }
+
+	UFUNCTION(BlueprintPure, Category="Orbital|Pool")
+	int32 GetNumPooled(TSubclassOf<AActor> ActorClass) const;
+
+	UFUNCTION(BlueprintCallable, Category="Orbital|Pool")
+	void ResetPoolCounters();
+
+private:
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FOrbitalActorPoolBucket> Buckets;
+
+	TSet<const AActor*> PooledActors;
+
+	int32 PoolHits = 0;
+	int32 PoolMisses = 0;
+};
@@ -0,0 +1,489 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalDroneSwarm.h"
+#include "OrbitalShipPawn.h"
+#include "ShipSystemsComponent.h"
+#include "OrbitalSimulationRules.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Async/ParallelFor.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Drone Swarm Tick"), STAT_OrbitalSwarmTick, STATGROUP_OrbitalSalvage);
+DECLARE_CYCLE_STAT(TEXT("Drone Swarm Reclassify"), STAT_OrbitalSwarmReclassify, STATGROUP_OrbitalSalvage);
+DECLARE_CYCLE_STAT(TEXT("Drone Swarm Flush Transforms"), STAT_OrbitalSwarmFlushTransforms, STATGROUP_OrbitalSalvage);
+DECLARE_CYCLE_STAT(TEXT("Drone Swarm Raycast"), STAT_OrbitalSwarmRaycast, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Drones Simulated"), STAT_OrbitalDronesSimulated, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Drone Buffer Growths"), STAT_OrbitalDroneBufferGrowths, STATGROUP_OrbitalSalvage);
+DECLARE_MEMORY_STAT(TEXT("Drone Buffers"), STAT_OrbitalDroneBufferMemory, STATGROUP_OrbitalSalvage);
+
+namespace
+{
+	const FVector DroneScale(1.8f, 1.8f, 1.8f);
+}
+
+void FOrbitalDroneBuffer::Reserve(int32 Count)
+{
+	PositionX.Reserve(Count);
+	PositionY.Reserve(Count);
+	PositionZ.Reserve(Count);
+	Yaw.Reserve(Count);
+	Health.Reserve(Count);
+	AttackAccumulator.Reserve(Count);
+}
+
+void FOrbitalDroneBuffer::Add(const FVector& Location, float InHealth)
+{
+	PositionX.Add(Location.X);
+	PositionY.Add(Location.Y);
+	PositionZ.Add(Location.Z);
+	Yaw.Add(0.0f);
+	Health.Add(InHealth);
+	AttackAccumulator.Add(0.0f);
+}
+
+void FOrbitalDroneBuffer::Swap(int32 IndexA, int32 IndexB)
+{
+	PositionX.Swap(IndexA, IndexB);
+	PositionY.Swap(IndexA, IndexB);
+	PositionZ.Swap(IndexA, IndexB);
+	Yaw.Swap(IndexA, IndexB);
+	Health.Swap(IndexA, IndexB);
+	AttackAccumulator.Swap(IndexA, IndexB);
+}
+
+void FOrbitalDroneBuffer::Pop()
+{
+	PositionX.Pop(EAllowShrinking::No);
+	PositionY.Pop(EAllowShrinking::No);
+	PositionZ.Pop(EAllowShrinking::No);
+	Yaw.Pop(EAllowShrinking::No);
+	Health.Pop(EAllowShrinking::No);
+	AttackAccumulator.Pop(EAllowShrinking::No);
+}
+
+void FOrbitalDroneBuffer::Reset()
+{
+	PositionX.Reset();
+	PositionY.Reset();
+	PositionZ.Reset();
+	Yaw.Reset();
+	Health.Reset();
+	AttackAccumulator.Reset();
+}
+
+SIZE_T FOrbitalDroneBuffer::GetAllocatedSize() const
+{
+	return PositionX.GetAllocatedSize() + PositionY.GetAllocatedSize() + PositionZ.GetAllocatedSize()
+		+ Yaw.GetAllocatedSize() + Health.GetAllocatedSize() + AttackAccumulator.GetAllocatedSize();
+}
+
+AOrbitalDroneSwarm::AOrbitalDroneSwarm()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+
+	DroneInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("DroneInstances"));
+	DroneInstances->SetupAttachment(RootComponent);
+	DroneInstances->SetMobility(EComponentMobility::Movable);
+	DroneInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	DroneInstances->SetGenerateOverlapEvents(false);
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> SphereMesh(TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+	if (SphereMesh.Succeeded())
+	{
+		DroneInstances->SetStaticMesh(SphereMesh.Object);
+	}
+}
+
+void AOrbitalDroneSwarm::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_OrbitalDroneBufferMemory, ReportedMemory, 0);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+template<typename FunctorType>
+void AOrbitalDroneSwarm::ForEachBatch(int32 Count, FunctorType&& Func)
+{
+	const int32 BatchSize = FMath::Max(ParallelBatchSize, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Count, BatchSize);
+
+	ParallelFor(NumChunks, [&Func, BatchSize, Count](int32 ChunkIndex)
+	{
+		const int32 BeginIndex = ChunkIndex * BatchSize;
+		Func(ChunkIndex, BeginIndex, FMath::Min(BeginIndex + BatchSize, Count));
+	}, NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void AOrbitalDroneSwarm::Tick(float DeltaSeconds)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSwarmTick);
+
+	Super::Tick(DeltaSeconds);
+
+	if (Drones.Num() == 0)
+	{
+		return;
+	}
+
+	if (!IsValid(TargetShip))
+	{
+		TargetShip = Cast<AOrbitalShipPawn>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+		if (!TargetShip)
+		{
+			FlushTransforms();
+			return;
+		}
+	}
+
+	const FVector2D ShipLocation(TargetShip->GetActorLocation());
+
+	IdleCheckTimer += DeltaSeconds;
+	DormantCheckTimer += DeltaSeconds;
+
+	if (bNeedsFullReclassify || DormantCheckTimer >= DormantCheckInterval)
+	{
+		Reclassify(Drones.Num(), ShipLocation);
+		bNeedsFullReclassify = false;
+		DormantCheckTimer = 0.0f;
+		IdleCheckTimer = 0.0f;
+	}
+	else if (IdleCheckTimer >= IdleCheckInterval)
+	{
+		Reclassify(NumActive + NumIdle, ShipLocation);
+		IdleCheckTimer = 0.0f;
+	}
+
+	if (NumActive > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_OrbitalDronesSimulated, NumActive);
+		ChunkResults.SetNum(FMath::DivideAndRoundUp(NumActive, FMath::Max(ParallelBatchSize, 1)), EAllowShrinking::No);
+
+		ForEachBatch(NumActive, [this, DeltaSeconds, ShipLocation](int32 ChunkIndex, int32 BeginIndex, int32 EndIndex)
+		{
+			ChunkResults[ChunkIndex] = SimulateRange(BeginIndex, EndIndex, DeltaSeconds, ShipLocation);
+		});
+
+		FSimulationResult Total;
+		for (const FSimulationResult& ChunkResult : ChunkResults)
+		{
+			Total.HullDamage += ChunkResult.HullDamage;
+			Total.NumMoved += ChunkResult.NumMoved;
+		}
+
+		if (Total.NumMoved > 0)
+		{
+			MarkDirty(0, NumActive);
+		}
+
+		if (Total.HullDamage > 0.0f)
+		{
+			if (UShipSystemsComponent* Systems = TargetShip->GetShipSystems())
+			{
+				Systems->ApplyHullDamage(Total.HullDamage);
+			}
+		}
+	}
+
+	FlushTransforms();
+}
+
+AOrbitalDroneSwarm::FSimulationResult AOrbitalDroneSwarm::SimulateRange(int32 BeginIndex, int32 EndIndex, float DeltaSeconds, const FVector2D& ShipLocation)
+{
+	FSimulationResult Result;
+
+	const float ChaseRangeSq = FMath::Square(ChaseRange);
+	const float AttackRangeSq = FMath::Square(AttackRange);
+	const float Step = MoveSpeed * DeltaSeconds;
+
+	float* RESTRICT PosX = Drones.PositionX.GetData();
+	float* RESTRICT PosY = Drones.PositionY.GetData();
+	float* RESTRICT Yaw = Drones.Yaw.GetData();
+	float* RESTRICT Accumulator = Drones.AttackAccumulator.GetData();
+
+	for (int32 i = BeginIndex; i < EndIndex; ++i)
+	{
+		const float DeltaX = ShipLocation.X - PosX[i];
+		const float DeltaY = ShipLocation.Y - PosY[i];
+		const float DistSq = DeltaX * DeltaX + DeltaY * DeltaY;
+
+		if (DistSq <= ChaseRangeSq && DistSq > UE_KINDA_SMALL_NUMBER)
+		{
+			const float InvDist = FMath::InvSqrt(DistSq);
+			PosX[i] += DeltaX * InvDist * Step;
+			PosY[i] += DeltaY * InvDist * Step;
+			Yaw[i] = FMath::RadiansToDegrees(FMath::Atan2(DeltaY, DeltaX));
+			++Result.NumMoved;
+
+			if (DistSq <= AttackRangeSq)
+			{
+				Result.HullDamage += FOrbitalCombatRules::AccumulateDroneAttack(Accumulator[i], DeltaSeconds, HullDamagePerSecond);
+			}
+		}
+	}
+
+	return Result;
+}
+
+void AOrbitalDroneSwarm::Reclassify(int32 RangeEnd, const FVector2D& ShipLocation)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSwarmReclassify);
+
+	// Three-way partition of [0, RangeEnd). Dormant drones land at the end of the range, next to the
+	// existing Dormant tail, so a partial pass over Active+Idle keeps the whole buffer partitioned.
+	int32 Low = 0;
+	int32 Mid = 0;
+	int32 High = RangeEnd - 1;
+
+	while (Mid <= High)
+	{
+		switch (ClassifyDrone(Mid, ShipLocation))
+		{
+		case EOrbitalDroneLod::Active:
+			if (Low != Mid)
+			{
+				SwapDrones(Low, Mid);
+			}
+			++Low;
+			++Mid;
+			break;
+		case EOrbitalDroneLod::Idle:
+			++Mid;
+			break;
+		default:
+			if (Mid != High)
+			{
+				SwapDrones(Mid, High);
+			}
+			--High;
+			break;
+		}
+	}
+
+	NumActive = Low;
+	NumIdle = Mid - Low;
+}
+
+EOrbitalDroneLod AOrbitalDroneSwarm::ClassifyDrone(int32 DroneIndex, const FVector2D& ShipLocation) const
+{
+	const float DistSq = FVector2D::DistSquared(FVector2D(Drones.PositionX[DroneIndex], Drones.PositionY[DroneIndex]), ShipLocation);
+
+	if (DistSq <= FMath::Square(ChaseRange))
+	{
+		return EOrbitalDroneLod::Active;
+	}
+
+	return DistSq <= FMath::Square(FMath::Max(WakeRange, ChaseRange)) ? EOrbitalDroneLod::Idle : EOrbitalDroneLod::Dormant;
+}
+
+void AOrbitalDroneSwarm::SwapDrones(int32 IndexA, int32 IndexB)
+{
+	if (IndexA == IndexB)
+	{
+		return;
+	}
+
+	Drones.Swap(IndexA, IndexB);
+	MarkDirty(IndexA, IndexA + 1);
+	MarkDirty(IndexB, IndexB + 1);
+}
+
+void AOrbitalDroneSwarm::MarkDirty(int32 BeginIndex, int32 EndIndex)
+{
+	if (DirtyBegin >= DirtyEnd)
+	{
+		DirtyBegin = BeginIndex;
+		DirtyEnd = EndIndex;
+	}
+	else
+	{
+		DirtyBegin = FMath::Min(DirtyBegin, BeginIndex);
+		DirtyEnd = FMath::Max(DirtyEnd, EndIndex);
+	}
+}
+
+void AOrbitalDroneSwarm::FlushTransforms()
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSwarmFlushTransforms);
+
+	const int32 BeginIndex = DirtyBegin;
+	const int32 Count = FMath::Min(DirtyEnd, Drones.Num()) - BeginIndex;
+	DirtyBegin = DirtyEnd = 0;
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	InstanceTransforms.SetNum(Count, EAllowShrinking::No);
+	ForEachBatch(Count, [this, BeginIndex](int32 ChunkIndex, int32 ChunkBegin, int32 ChunkEnd)
+	{
+		for (int32 i = ChunkBegin; i < ChunkEnd; ++i)
+		{
+			InstanceTransforms[i] = MakeInstanceTransform(BeginIndex + i);
+		}
+	});
+
+	DroneInstances->BatchUpdateInstancesTransforms(BeginIndex, InstanceTransforms, true, true, true);
+	ReportMemory();
+}
+
+void AOrbitalDroneSwarm::AddDrones(TConstArrayView<FVector> Locations)
+{
+	if (Locations.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 RequiredCapacity = Drones.Num() + Locations.Num();
+	if (RequiredCapacity > Drones.PositionX.Max())
+	{
+		INC_DWORD_STAT(STAT_OrbitalDroneBufferGrowths);
+	}
+	Drones.Reserve(RequiredCapacity);
+
+	TArray<FTransform> NewTransforms;
+	NewTransforms.Reserve(Locations.Num());
+
+	for (const FVector& Location : Locations)
+	{
+		Drones.Add(Location, MaxHealth);
+		NewTransforms.Add(MakeInstanceTransform(Drones.Num() - 1));
+	}
+
+	DroneInstances->AddInstances(NewTransforms, false, true);
+	ReportMemory();
+
+	// New drones are appended to the Dormant tail; bucket them properly on the next tick.
+	bNeedsFullReclassify = true;
+}
+
+void AOrbitalDroneSwarm::ClearSwarm()
+{
+	Drones.Reset();
+	NumActive = 0;
+	NumIdle = 0;
+	DirtyBegin = DirtyEnd = 0;
+	DroneInstances->ClearInstances();
+}
+
+void AOrbitalDroneSwarm::ApplyMiningDamage(int32 DroneIndex, float DamageAmount)
+{
+	if (!Drones.Health.IsValidIndex(DroneIndex))
+	{
+		return;
+	}
+
+	if (FOrbitalCombatRules::ApplyDroneDamage(Drones.Health[DroneIndex], DamageAmount))
+	{
+		if (IsValid(TargetShip))
+		{
+			if (UShipSystemsComponent* Systems = TargetShip->GetShipSystems())
+			{
+				Systems->Credits += BountyCredits;
+			}
+		}
+
+		RemoveDrone(DroneIndex);
+	}
+}
+
+int32 AOrbitalDroneSwarm::GetDroneCountInLod(EOrbitalDroneLod Lod) const
+{
+	switch (Lod)
+	{
+	case EOrbitalDroneLod::Active:
+		return NumActive;
+	case EOrbitalDroneLod::Idle:
+		return NumIdle;
+	default:
+		return Drones.Num() - NumActive - NumIdle;
+	}
+}
+
+int32 AOrbitalDroneSwarm::RaycastDrones(const FVector& Start, const FVector& End, float& OutDistance) const
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSwarmRaycast);
+
+	FVector Direction;
+	float Length = 0.0f;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+
+	const float RadiusSq = FMath::Square(DroneRadius);
+	int32 BestIndex = INDEX_NONE;
+	float BestDistance = Length;
+
+	// Dormant drones are beyond WakeRange, well outside beam range, so they are skipped.
+	for (int32 i = 0; i < NumActive + NumIdle; ++i)
+	{
+		const FVector ToDrone(Drones.PositionX[i] - Start.X, Drones.PositionY[i] - Start.Y, Drones.PositionZ[i] - Start.Z);
+		const float Along = FVector::DotProduct(ToDrone, Direction);
+		const float MissSq = ToDrone.SizeSquared() - FMath::Square(Along);
+		if (Along < 0.0f || MissSq > RadiusSq)
+		{
+			continue;
+		}
+
+		const float EntryDistance = FMath::Max(Along - FMath::Sqrt(RadiusSq - MissSq), 0.0f);
+		if (EntryDistance < BestDistance)
+		{
+			BestDistance = EntryDistance;
+			BestIndex = i;
+		}
+	}
+
+	OutDistance = BestDistance;
+	return BestIndex;
+}
+
+FVector AOrbitalDroneSwarm::GetDroneLocation(int32 DroneIndex) const
+{
+	if (!Drones.PositionX.IsValidIndex(DroneIndex))
+	{
+		return FVector::ZeroVector;
+	}
+
+	return FVector(Drones.PositionX[DroneIndex], Drones.PositionY[DroneIndex], Drones.PositionZ[DroneIndex]);
+}
+
+FTransform AOrbitalDroneSwarm::MakeInstanceTransform(int32 DroneIndex) const
+{
+	return FTransform(FRotator(0.0f, Drones.Yaw[DroneIndex], 0.0f), GetDroneLocation(DroneIndex), DroneScale);
+}
+
+void AOrbitalDroneSwarm::RemoveDrone(int32 DroneIndex)
+{
+	// Walk the hole to the end of each bucket in turn so [Active | Idle | Dormant] stays contiguous.
+	int32 Hole = DroneIndex;
+
+	if (Hole < NumActive)
+	{
+		SwapDrones(Hole, NumActive - 1);
+		Hole = NumActive - 1;
+		--NumActive;
+		++NumIdle;
+	}
+
+	if (Hole < NumActive + NumIdle)
+	{
+		const int32 LastIdle = NumActive + NumIdle - 1;
+		SwapDrones(Hole, LastIdle);
+		Hole = LastIdle;
+		--NumIdle;
+	}
+
+	const int32 LastIndex = Drones.Num() - 1;
+	SwapDrones(Hole, LastIndex);
+
+	Drones.Pop();
+	DroneInstances->RemoveInstance(LastIndex);
+}
+
+void AOrbitalDroneSwarm::ReportMemory()
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_OrbitalDroneBufferMemory, ReportedMemory,
+		Drones.GetAllocatedSize() + InstanceTransforms.GetAllocatedSize() + ChunkResults.GetAllocatedSize());
+}
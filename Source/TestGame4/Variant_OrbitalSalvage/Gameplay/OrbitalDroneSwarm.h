@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "OrbitalTypes.h"
+#include "OrbitalDroneSwarm.generated.h"
+
+class UInstancedStaticMeshComponent;
+class AOrbitalShipPawn;
+
+/**
+ * Structure-of-arrays state for every drone in a swarm.
+ * Element i always matches instance i of the swarm's instanced mesh component.
+ */
+struct FOrbitalDroneBuffer
+{
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+	TArray<float> Yaw;
+	TArray<float> Health;
+	TArray<float> AttackAccumulator;
+
+	int32 Num() const { return PositionX.Num(); }
+	void Reserve(int32 Count);
+	void Add(const FVector& Location, float InHealth);
+	void Swap(int32 IndexA, int32 IndexB);
+	void Pop();
+	void Reset();
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Batched hostile drone simulation.
+ * Replaces one ticking actor per drone with a single tick that updates contiguous arrays (in parallel for
+ * large swarms) and pushes changed transforms to one instanced mesh in a single batch.
+ *
+ * Drones are kept partitioned by distance to the ship: [Active | Idle | Dormant]. Only the Active range is
+ * simulated every frame; Idle drones are re-bucketed a few times a second and Dormant drones sleep until
+ * a coarse once-a-second distance pass wakes them, so tick cost follows nearby drones rather than swarm size.
+ * Drones carry no collision; the mining beam tests them analytically through RaycastDrones.
+ */
+UCLASS()
+class AOrbitalDroneSwarm : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOrbitalDroneSwarm();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UInstancedStaticMeshComponent* DroneInstances;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float MaxHealth = 90.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float MoveSpeed = 900.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float ChaseRange = 5500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float AttackRange = 550.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float HullDamagePerSecond = 8.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	int32 BountyCredits = 120;
+
+	/** Radius used for beam hit tests; matches the scaled sphere mesh. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float DroneRadius = 90.0f;
+
+	/** Drones beyond ChaseRange but within this distance are Idle; anything further is Dormant. */
+	UPROPERTY(EditAnywhere, Category="Drone|LOD")
+	float WakeRange = 9000.0f;
+
+	/** Seconds between re-bucketing the Active and Idle ranges. */
+	UPROPERTY(EditAnywhere, Category="Drone|LOD")
+	float IdleCheckInterval = 0.25f;
+
+	/** Seconds between the coarse distance pass over every drone, including Dormant ones. */
+	UPROPERTY(EditAnywhere, Category="Drone|LOD")
+	float DormantCheckInterval = 1.0f;
+
+	/** Ranges at least this large are processed with ParallelFor, in chunks of this many drones. */
+	UPROPERTY(EditAnywhere, Category="Drone|Performance")
+	int32 ParallelBatchSize = 256;
+
+	void AddDrones(TConstArrayView<FVector> Locations);
+
+	UFUNCTION(BlueprintCallable, Category="Drone")
+	void ClearSwarm();
+
+	UFUNCTION(BlueprintCallable, Category="Drone")
+	void ApplyMiningDamage(int32 DroneIndex, float DamageAmount);
+
+	/** Returns the first Active or Idle drone hit by the segment and its distance from Start, or INDEX_NONE. */
+	int32 RaycastDrones(const FVector& Start, const FVector& End, float& OutDistance) const;
+
+	UFUNCTION(BlueprintPure, Category="Drone")
+	int32 GetDroneCount() const { return Drones.Num(); }
+
+	UFUNCTION(BlueprintPure, Category="Drone|LOD")
+	int32 GetDroneCountInLod(EOrbitalDroneLod Lod) const;
+
+	UFUNCTION(BlueprintPure, Category="Drone")
+	FVector GetDroneLocation(int32 DroneIndex) const;
+
+private:
+	struct FSimulationResult
+	{
+		float HullDamage = 0.0f;
+		int32 NumMoved = 0;
+	};
+
+	UPROPERTY()
+	TObjectPtr<AOrbitalShipPawn> TargetShip;
+
+	FOrbitalDroneBuffer Drones;
+	int32 NumActive = 0;
+	int32 NumIdle = 0;
+
+	float IdleCheckTimer = 0.0f;
+	float DormantCheckTimer = 0.0f;
+	bool bNeedsFullReclassify = false;
+
+	/** Instances in [DirtyBegin, DirtyEnd) need their transforms pushed to the mesh. */
+	int32 DirtyBegin = 0;
+	int32 DirtyEnd = 0;
+
+	/** Scratch buffers reused every tick so steady-state simulation does not allocate. */
+	TArray<FTransform> InstanceTransforms;
+	TArray<FSimulationResult> ChunkResults;
+
+	/** Bytes of the buffers above last reported to the drone memory stat. */
+	SIZE_T ReportedMemory = 0;
+
+	template<typename FunctorType>
+	void ForEachBatch(int32 Count, FunctorType&& Func);
+
+	FSimulationResult SimulateRange(int32 BeginIndex, int32 EndIndex, float DeltaSeconds, const FVector2D& ShipLocation);
+	void Reclassify(int32 RangeEnd, const FVector2D& ShipLocation);
+	EOrbitalDroneLod ClassifyDrone(int32 DroneIndex, const FVector2D& ShipLocation) const;
+	void SwapDrones(int32 IndexA, int32 IndexB);
+	void MarkDirty(int32 BeginIndex, int32 EndIndex);
+	void FlushTransforms();
+	FTransform MakeInstanceTransform(int32 DroneIndex) const;
+	void RemoveDrone(int32 DroneIndex);
+	void ReportMemory();
+};
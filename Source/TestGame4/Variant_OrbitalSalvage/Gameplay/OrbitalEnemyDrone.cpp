@@ -3,9 +3,13 @@
 #include "OrbitalEnemyDrone.h"
 #include "OrbitalShipPawn.h"
 #include "ShipSystemsComponent.h"
+#include "OrbitalSimulationRules.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Drone Tick"), STAT_OrbitalEnemyDroneTick, STATGROUP_OrbitalSalvage);
 
 AOrbitalEnemyDrone::AOrbitalEnemyDrone()
 {
@@ -30,12 +34,21 @@ void AOrbitalEnemyDrone::BeginPlay()
 {
 	Super::BeginPlay();
 
+	OnAcquiredFromPool();
+}
+
+void AOrbitalEnemyDrone::OnAcquiredFromPool()
+{
 	Health = MaxHealth;
+	AttackTickAccumulator = 0.0f;
+	SetActorTickInterval(0.0f);
 	AcquireTargetShip();
 }
 
 void AOrbitalEnemyDrone::Tick(float DeltaTime)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalEnemyDroneTick);
+
 	Super::Tick(DeltaTime);
 
 	if (!IsValid(TargetShip))
@@ -54,9 +67,13 @@ void AOrbitalEnemyDrone::Tick(float DeltaTime)
 
 	if (Dist2D > ChaseRange)
 	{
+		// Out of chase range there is nothing to do but wait, so only poll a few times a second.
+		SetActorTickInterval(IdleTickInterval);
 		return;
 	}
 
+	SetActorTickInterval(0.0f);
+
 	const FVector Dir2D = FVector(Delta.X, Delta.Y, 0.0f).GetSafeNormal();
 	const FVector NewLocation = MyLocation + Dir2D * MoveSpeed * DeltaTime;
 	SetActorLocation(FVector(NewLocation.X, NewLocation.Y, MyLocation.Z));
@@ -66,14 +83,12 @@ void AOrbitalEnemyDrone::Tick(float DeltaTime)
 
 	if (Dist2D <= AttackRange)
 	{
-		AttackTickAccumulator += DeltaTime;
-		if (AttackTickAccumulator >= 0.2f)
+		const float HullDamage = FOrbitalCombatRules::AccumulateDroneAttack(AttackTickAccumulator, DeltaTime, HullDamagePerSecond);
+		if (HullDamage > 0.0f)
 		{
-			AttackTickAccumulator = 0.0f;
-
 			if (UShipSystemsComponent* Systems = TargetShip->GetShipSystems())
 			{
-				Systems->ApplyHullDamage(HullDamagePerSecond * 0.2f);
+				Systems->ApplyHullDamage(HullDamage);
 			}
 		}
 	}
@@ -81,8 +96,7 @@ void AOrbitalEnemyDrone::Tick(float DeltaTime)
 
 void AOrbitalEnemyDrone::ApplyMiningDamage(float DamageAmount)
 {
-	Health -= DamageAmount;
-	if (Health <= 0.0f)
+	if (FOrbitalCombatRules::ApplyDroneDamage(Health, DamageAmount))
 	{
 		if (IsValid(TargetShip))
 		{
@@ -92,7 +106,14 @@ void AOrbitalEnemyDrone::ApplyMiningDamage(float DamageAmount)
 			}
 		}
 
-		Destroy();
+		if (UOrbitalActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UOrbitalActorPoolSubsystem>())
+		{
+			Pool->ReleaseActor(this);
+		}
+		else
+		{
+			Destroy();
+		}
 	}
 }
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OrbitalActorPoolSubsystem.h"
 #include "OrbitalEnemyDrone.generated.h"
 
 class UStaticMeshComponent;
@@ -13,7 +14,7 @@ class AOrbitalShipPawn;
  * Lightweight hostile drone for prototype combat pressure.
  */
 UCLASS()
-class AOrbitalEnemyDrone : public AActor
+class AOrbitalEnemyDrone : public AActor, public IOrbitalPooledActor
 {
 	GENERATED_BODY()
 
@@ -22,6 +23,7 @@ public:
 
 	virtual void Tick(float DeltaTime) override;
 	virtual void BeginPlay() override;
+	virtual void OnAcquiredFromPool() override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UStaticMeshComponent* MeshComponent;
@@ -47,6 +49,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
 	int32 BountyCredits = 120;
 
+	/** Tick interval used while the ship is outside ChaseRange. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Drone")
+	float IdleTickInterval = 0.25f;
+
 	UFUNCTION(BlueprintCallable, Category="Drone")
 	void ApplyMiningDamage(float DamageAmount);
 
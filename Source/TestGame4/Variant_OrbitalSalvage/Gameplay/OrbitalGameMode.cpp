@@ -9,6 +9,7 @@
 #include "OrbitalHUD.h"
 #include "MissionComponent.h"
 #include "ShipSystemsComponent.h"
+#include "OrbitalSimulationRules.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
@@ -18,6 +19,9 @@
 #include "EngineUtils.h"
 #include "Components/LightComponent.h"
 #include "Components/SkyLightComponent.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Game Mode Tick"), STAT_OrbitalGameModeTick, STATGROUP_OrbitalSalvage);
 
 AOrbitalGameMode::AOrbitalGameMode()
 {
@@ -44,6 +48,8 @@ void AOrbitalGameMode::BeginPlay()
 
 void AOrbitalGameMode::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalGameModeTick);
+
 	Super::Tick(DeltaSeconds);
 
 	if (StatusMessageTimer > 0.0f)
@@ -99,11 +105,9 @@ void AOrbitalGameMode::HandleDockRequest(AOrbitalStationActor* Station, AOrbital
 	const int32 CargoRevenue = Systems->SellAllCargo();
 
 	// Auto service operations using credits.
-	const float HullMissing = Systems->MaxHull - Systems->Hull;
+	const float HullMissing = Systems->MaxHull - Systems->GetHull();
 	const float FuelMissing = Systems->MaxFuel - Systems->Fuel;
-	const int32 RepairCost = FMath::CeilToInt(HullMissing * 3.0f);
-	const int32 FuelCost = FMath::CeilToInt(FuelMissing * 2.0f);
-	const int32 ServiceCost = RepairCost + FuelCost;
+	const int32 ServiceCost = FOrbitalDockingRules::QuoteService(HullMissing, FuelMissing).GetTotal();
 
 	if (Systems->Credits >= ServiceCost)
 	{
@@ -133,9 +137,7 @@ void AOrbitalGameMode::HandleJumpGateRequest(AOrbitalJumpGateActor* Gate, AOrbit
 		return;
 	}
 
-	if (MissionComponent &&
-		MissionComponent->CurrentStage == EOrbitalMissionStage::RetrieveBlackBox &&
-		Gate->TargetSector == EOrbitalSectorId::Ruins)
+	if (MissionComponent && FOrbitalMissionRules::IsJumpLocked(MissionComponent->CurrentStage, Gate->TargetSector))
 	{
 		SetStatusMessage(TEXT("Mission lock: recover the black box before jumping to Ruins."));
 		return;
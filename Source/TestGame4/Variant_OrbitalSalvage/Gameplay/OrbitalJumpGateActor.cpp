@@ -2,6 +2,7 @@
 
 #include "OrbitalJumpGateActor.h"
 #include "OrbitalShipPawn.h"
+#include "OrbitalSpatialIndexSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "UObject/ConstructorHelpers.h"
 
@@ -25,6 +26,36 @@ AOrbitalJumpGateActor::AOrbitalJumpGateActor()
 	}
 }
 
+void AOrbitalJumpGateActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnAcquiredFromPool();
+}
+
+void AOrbitalJumpGateActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OnReturnedToPool();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOrbitalJumpGateActor::OnAcquiredFromPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->RegisterActor(this, ActivationRange);
+	}
+}
+
+void AOrbitalJumpGateActor::OnReturnedToPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterActor(this);
+	}
+}
+
 bool AOrbitalJumpGateActor::CanShipUseGate(const AOrbitalShipPawn* Ship) const
 {
 	if (!Ship)
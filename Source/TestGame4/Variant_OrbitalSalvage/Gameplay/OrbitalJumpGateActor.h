@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "OrbitalTypes.h"
+#include "OrbitalActorPoolSubsystem.h"
 #include "OrbitalJumpGateActor.generated.h"
 
 class UStaticMeshComponent;
@@ -14,13 +15,18 @@ class AOrbitalShipPawn;
  * Jump interaction point used to move between sectors.
  */
 UCLASS()
-class AOrbitalJumpGateActor : public AActor
+class AOrbitalJumpGateActor : public AActor, public IOrbitalPooledActor
 {
 	GENERATED_BODY()
 
 public:
 	AOrbitalJumpGateActor();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UStaticMeshComponent* MeshComponent;
 
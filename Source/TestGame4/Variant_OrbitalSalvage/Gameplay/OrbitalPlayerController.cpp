@@ -5,6 +5,7 @@
 #include "OrbitalGameMode.h"
 #include "OrbitalStationActor.h"
 #include "OrbitalJumpGateActor.h"
+#include "OrbitalSpatialIndexSubsystem.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputAction.h"
@@ -13,7 +14,6 @@
 #include "InputMappingContext.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "Kismet/GameplayStatics.h"
 
 AOrbitalPlayerController::AOrbitalPlayerController()
 {
@@ -121,28 +121,20 @@ void AOrbitalPlayerController::InteractPressed(const FInputActionValue& Value)
 		}
 	}
 
-	// Try dock interaction first.
-	TArray<AActor*> Stations;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AOrbitalStationActor::StaticClass(), Stations);
-	float BestDockDistSq = FLT_MAX;
-	AOrbitalStationActor* BestStation = nullptr;
-
-	for (AActor* Candidate : Stations)
+	UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>();
+	if (!SpatialIndex)
 	{
-		AOrbitalStationActor* Station = Cast<AOrbitalStationActor>(Candidate);
-		if (!Station || !Station->CanDockShip(ControlledShip))
-		{
-			continue;
-		}
-
-		const float DistSq = FVector::DistSquared2D(ControlledShip->GetActorLocation(), Station->GetActorLocation());
-		if (DistSq < BestDockDistSq)
-		{
-			BestDockDistSq = DistSq;
-			BestStation = Station;
-		}
+		return;
 	}
 
+	// Only interactables in the cells around the ship are considered; the range checks below are the narrow phase.
+	const FVector ShipLocation = ControlledShip->GetActorLocation();
+	const float QueryRadius = SpatialIndex->GetMaxInteractionRange();
+
+	// Try dock interaction first.
+	AOrbitalStationActor* BestStation = SpatialIndex->FindNearestInRadius<AOrbitalStationActor>(ShipLocation, QueryRadius,
+		[this](const AOrbitalStationActor* Station) { return Station->CanDockShip(ControlledShip); });
+
 	if (BestStation)
 	{
 		OrbitalGameMode->HandleDockRequest(BestStation, ControlledShip);
@@ -150,18 +142,12 @@ void AOrbitalPlayerController::InteractPressed(const FInputActionValue& Value)
 	}
 
 	// Then try jump gate interaction.
-	TArray<AActor*> Gates;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AOrbitalJumpGateActor::StaticClass(), Gates);
-	for (AActor* Candidate : Gates)
+	AOrbitalJumpGateActor* BestGate = SpatialIndex->FindNearestInRadius<AOrbitalJumpGateActor>(ShipLocation, QueryRadius,
+		[this](const AOrbitalJumpGateActor* Gate) { return Gate->CanShipUseGate(ControlledShip); });
+
+	if (BestGate)
 	{
-		if (AOrbitalJumpGateActor* Gate = Cast<AOrbitalJumpGateActor>(Candidate))
-		{
-			if (Gate->CanShipUseGate(ControlledShip))
-			{
-				OrbitalGameMode->HandleJumpGateRequest(Gate, ControlledShip);
-				return;
-			}
-		}
+		OrbitalGameMode->HandleJumpGateRequest(BestGate, ControlledShip);
 	}
 }
 
@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalResourceField.h"
+#include "OrbitalSimulationRules.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Algo/Count.h"
+#include "TestGame4Stats.h"
+
+DECLARE_MEMORY_STAT(TEXT("Resource Node Buffers"), STAT_OrbitalResourceNodeMemory, STATGROUP_OrbitalSalvage);
+
+void FOrbitalResourceNodeBuffer::Reserve(int32 Count)
+{
+	UnitsRemaining.Reserve(Count);
+	MiningResistance.Reserve(Count);
+	UnitVolume.Reserve(Count);
+	UnitCreditValue.Reserve(Count);
+	ResourceType.Reserve(Count);
+	ContainsBlackBox.Reserve(Count);
+}
+
+void FOrbitalResourceNodeBuffer::Add(EOrbitalResourceType Type, float Units, float Resistance, float Volume, int32 CreditValue, bool bBlackBox)
+{
+	UnitsRemaining.Add(Units);
+	MiningResistance.Add(Resistance);
+	UnitVolume.Add(Volume);
+	UnitCreditValue.Add(CreditValue);
+	ResourceType.Add(Type);
+	ContainsBlackBox.Add(bBlackBox);
+}
+
+void FOrbitalResourceNodeBuffer::RemoveAtSwap(int32 Index)
+{
+	const int32 LastIndex = Num() - 1;
+
+	UnitsRemaining.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MiningResistance.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	UnitVolume.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	UnitCreditValue.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ResourceType.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// TBitArray has no swap-remove; mirror it by hand so the bit stays aligned with the other arrays.
+	ContainsBlackBox[Index] = ContainsBlackBox[LastIndex];
+	ContainsBlackBox.RemoveAt(LastIndex);
+}
+
+void FOrbitalResourceNodeBuffer::Reset()
+{
+	UnitsRemaining.Reset();
+	MiningResistance.Reset();
+	UnitVolume.Reset();
+	UnitCreditValue.Reset();
+	ResourceType.Reset();
+	ContainsBlackBox.Reset();
+}
+
+SIZE_T FOrbitalResourceNodeBuffer::GetAllocatedSize() const
+{
+	return UnitsRemaining.GetAllocatedSize() + MiningResistance.GetAllocatedSize() + UnitVolume.GetAllocatedSize()
+		+ UnitCreditValue.GetAllocatedSize() + ResourceType.GetAllocatedSize() + ContainsBlackBox.GetAllocatedSize();
+}
+
+AOrbitalResourceField::AOrbitalResourceField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+
+	AsteroidInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("AsteroidInstances"));
+	AsteroidInstances->SetupAttachment(RootComponent);
+
+	WreckInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("WreckInstances"));
+	WreckInstances->SetupAttachment(RootComponent);
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> SphereMesh(TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+
+	for (UInstancedStaticMeshComponent* Instances : { AsteroidInstances, WreckInstances })
+	{
+		Instances->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+		Instances->SetCollisionProfileName(TEXT("BlockAllDynamic"));
+		Instances->SetSimulatePhysics(false);
+		Instances->SetGenerateOverlapEvents(false);
+
+		if (SphereMesh.Succeeded())
+		{
+			Instances->SetStaticMesh(SphereMesh.Object);
+		}
+	}
+}
+
+void AOrbitalResourceField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_OrbitalResourceNodeMemory, ReportedMemory, 0);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOrbitalResourceField::AddNodes(TConstArrayView<FOrbitalResourceNodeSpawn> Nodes)
+{
+	TArray<FTransform> AsteroidTransforms;
+	TArray<FTransform> WreckTransforms;
+
+	const int32 NumAsteroids = Algo::CountIf(Nodes, [](const FOrbitalResourceNodeSpawn& Node) { return Node.Kind == EOrbitalResourceNodeKind::Asteroid; });
+	const int32 NumWrecks = Nodes.Num() - NumAsteroids;
+	AsteroidNodes.Reserve(AsteroidNodes.Num() + NumAsteroids);
+	WreckNodes.Reserve(WreckNodes.Num() + NumWrecks);
+	AsteroidTransforms.Reserve(NumAsteroids);
+	WreckTransforms.Reserve(NumWrecks);
+
+	for (const FOrbitalResourceNodeSpawn& Node : Nodes)
+	{
+		const FTransform InstanceTransform(FRotator::ZeroRotator, Node.Location, FVector(Node.Scale));
+
+		GetBuffer(Node.Kind).Add(Node.ResourceType, Node.Units, Node.MiningResistance, Node.UnitVolume, Node.UnitCreditValue, Node.bContainsBlackBox);
+
+		if (Node.Kind == EOrbitalResourceNodeKind::Asteroid)
+		{
+			AsteroidTransforms.Add(InstanceTransform);
+		}
+		else
+		{
+			WreckTransforms.Add(InstanceTransform);
+		}
+	}
+
+	// One batched add per component keeps instance indices aligned with the buffers and rebuilds render data once.
+	if (AsteroidTransforms.Num() > 0)
+	{
+		AsteroidInstances->AddInstances(AsteroidTransforms, false, true);
+	}
+	if (WreckTransforms.Num() > 0)
+	{
+		WreckInstances->AddInstances(WreckTransforms, false, true);
+	}
+
+	ReportMemory();
+}
+
+void AOrbitalResourceField::ClearField()
+{
+	AsteroidNodes.Reset();
+	WreckNodes.Reset();
+	AsteroidInstances->ClearInstances();
+	WreckInstances->ClearInstances();
+}
+
+float AOrbitalResourceField::ExtractResource(EOrbitalResourceNodeKind Kind, int32 InstanceIndex, float RequestedUnits, EOrbitalResourceType& OutResourceType, float& OutUnitVolume, int32& OutCreditValue, bool& bOutRecoveredBlackBox)
+{
+	bOutRecoveredBlackBox = false;
+
+	FOrbitalResourceNodeBuffer& Buffer = GetBuffer(Kind);
+	if (!Buffer.UnitsRemaining.IsValidIndex(InstanceIndex))
+	{
+		return 0.0f;
+	}
+
+	float& UnitsRemaining = Buffer.UnitsRemaining[InstanceIndex];
+	OutResourceType = Buffer.ResourceType[InstanceIndex];
+	OutUnitVolume = Buffer.UnitVolume[InstanceIndex];
+	OutCreditValue = Buffer.UnitCreditValue[InstanceIndex];
+
+	if (RequestedUnits <= 0.0f || UnitsRemaining <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float Extracted = FOrbitalMiningRules::Extract(RequestedUnits, Buffer.MiningResistance[InstanceIndex], UnitsRemaining);
+
+	if (Buffer.ContainsBlackBox[InstanceIndex] && Kind == EOrbitalResourceNodeKind::Wreck)
+	{
+		bOutRecoveredBlackBox = true;
+		Buffer.ContainsBlackBox[InstanceIndex] = false;
+	}
+
+	if (FOrbitalMiningRules::IsDepleted(UnitsRemaining))
+	{
+		RemoveNode(Kind, InstanceIndex);
+	}
+
+	return Extracted;
+}
+
+bool AOrbitalResourceField::GetNodeKindForComponent(const UPrimitiveComponent* Component, EOrbitalResourceNodeKind& OutKind) const
+{
+	if (Component == AsteroidInstances)
+	{
+		OutKind = EOrbitalResourceNodeKind::Asteroid;
+		return true;
+	}
+
+	if (Component == WreckInstances)
+	{
+		OutKind = EOrbitalResourceNodeKind::Wreck;
+		return true;
+	}
+
+	return false;
+}
+
+int32 AOrbitalResourceField::GetNodeCount(EOrbitalResourceNodeKind Kind) const
+{
+	return GetBuffer(Kind).Num();
+}
+
+float AOrbitalResourceField::GetUnitsRemaining(EOrbitalResourceNodeKind Kind, int32 InstanceIndex) const
+{
+	const FOrbitalResourceNodeBuffer& Buffer = GetBuffer(Kind);
+	return Buffer.UnitsRemaining.IsValidIndex(InstanceIndex) ? Buffer.UnitsRemaining[InstanceIndex] : 0.0f;
+}
+
+FOrbitalResourceNodeBuffer& AOrbitalResourceField::GetBuffer(EOrbitalResourceNodeKind Kind)
+{
+	return Kind == EOrbitalResourceNodeKind::Asteroid ? AsteroidNodes : WreckNodes;
+}
+
+const FOrbitalResourceNodeBuffer& AOrbitalResourceField::GetBuffer(EOrbitalResourceNodeKind Kind) const
+{
+	return Kind == EOrbitalResourceNodeKind::Asteroid ? AsteroidNodes : WreckNodes;
+}
+
+UInstancedStaticMeshComponent* AOrbitalResourceField::GetInstances(EOrbitalResourceNodeKind Kind) const
+{
+	return Kind == EOrbitalResourceNodeKind::Asteroid ? AsteroidInstances : WreckInstances;
+}
+
+void AOrbitalResourceField::RemoveNode(EOrbitalResourceNodeKind Kind, int32 InstanceIndex)
+{
+	FOrbitalResourceNodeBuffer& Buffer = GetBuffer(Kind);
+	UInstancedStaticMeshComponent* Instances = GetInstances(Kind);
+	const int32 LastIndex = Buffer.Num() - 1;
+
+	// Move the last instance into the freed slot so the component and the buffers swap-remove identically.
+	if (InstanceIndex != LastIndex)
+	{
+		FTransform LastTransform;
+		Instances->GetInstanceTransform(LastIndex, LastTransform, true);
+		Instances->UpdateInstanceTransform(InstanceIndex, LastTransform, true, true);
+	}
+
+	Instances->RemoveInstance(LastIndex);
+	Buffer.RemoveAtSwap(InstanceIndex);
+}
+
+void AOrbitalResourceField::ReportMemory()
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_OrbitalResourceNodeMemory, ReportedMemory, AsteroidNodes.GetAllocatedSize() + WreckNodes.GetAllocatedSize());
+}
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "OrbitalTypes.h"
+#include "OrbitalSectorGenerator.h"
+#include "OrbitalResourceField.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UPrimitiveComponent;
+
+/**
+ * Structure-of-arrays storage for every node of one kind.
+ * Element i always matches instance i of the kind's instanced mesh component.
+ */
+struct FOrbitalResourceNodeBuffer
+{
+	TArray<float> UnitsRemaining;
+	TArray<float> MiningResistance;
+	TArray<float> UnitVolume;
+	TArray<int32> UnitCreditValue;
+	TArray<EOrbitalResourceType> ResourceType;
+	TBitArray<> ContainsBlackBox;
+
+	int32 Num() const { return UnitsRemaining.Num(); }
+	void Reserve(int32 Count);
+	void Add(EOrbitalResourceType Type, float Units, float Resistance, float Volume, int32 CreditValue, bool bBlackBox);
+	void RemoveAtSwap(int32 Index);
+	void Reset();
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Data-oriented asteroid/wreck field.
+ * Node state lives in per-kind SoA buffers and every node of a kind is drawn (and traced against)
+ * through a single instanced static mesh component, so belt density no longer costs one actor per node.
+ */
+UCLASS()
+class AOrbitalResourceField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOrbitalResourceField();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UInstancedStaticMeshComponent* AsteroidInstances;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	UInstancedStaticMeshComponent* WreckInstances;
+
+	void AddNodes(TConstArrayView<FOrbitalResourceNodeSpawn> Nodes);
+
+	UFUNCTION(BlueprintCallable, Category="Resource")
+	void ClearField();
+
+	UFUNCTION(BlueprintCallable, Category="Resource")
+	float ExtractResource(EOrbitalResourceNodeKind Kind, int32 InstanceIndex, float RequestedUnits, EOrbitalResourceType& OutResourceType, float& OutUnitVolume, int32& OutCreditValue, bool& bOutRecoveredBlackBox);
+
+	/** Maps a hit component back to the node kind it renders; false if the component is not owned by this field. */
+	bool GetNodeKindForComponent(const UPrimitiveComponent* Component, EOrbitalResourceNodeKind& OutKind) const;
+
+	UFUNCTION(BlueprintPure, Category="Resource")
+	int32 GetNodeCount(EOrbitalResourceNodeKind Kind) const;
+
+	UFUNCTION(BlueprintPure, Category="Resource")
+	float GetUnitsRemaining(EOrbitalResourceNodeKind Kind, int32 InstanceIndex) const;
+
+private:
+	FOrbitalResourceNodeBuffer AsteroidNodes;
+	FOrbitalResourceNodeBuffer WreckNodes;
+
+	/** Bytes of both node buffers last reported to the resource node memory stat. */
+	SIZE_T ReportedMemory = 0;
+
+	FOrbitalResourceNodeBuffer& GetBuffer(EOrbitalResourceNodeKind Kind);
+	const FOrbitalResourceNodeBuffer& GetBuffer(EOrbitalResourceNodeKind Kind) const;
+	UInstancedStaticMeshComponent* GetInstances(EOrbitalResourceNodeKind Kind) const;
+
+	void RemoveNode(EOrbitalResourceNodeKind Kind, int32 InstanceIndex);
+	void ReportMemory();
+};
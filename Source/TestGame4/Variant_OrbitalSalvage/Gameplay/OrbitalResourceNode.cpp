@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OrbitalResourceNode.h"
+#include "OrbitalSpatialIndexSubsystem.h"
+#include "OrbitalSimulationRules.h"
 #include "Components/StaticMeshComponent.h"
 #include "UObject/ConstructorHelpers.h"
 
@@ -23,6 +25,36 @@ AOrbitalResourceNode::AOrbitalResourceNode()
 	}
 }
 
+void AOrbitalResourceNode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnAcquiredFromPool();
+}
+
+void AOrbitalResourceNode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OnReturnedToPool();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOrbitalResourceNode::OnAcquiredFromPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->RegisterActor(this);
+	}
+}
+
+void AOrbitalResourceNode::OnReturnedToPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterActor(this);
+	}
+}
+
 float AOrbitalResourceNode::ExtractResource(float RequestedUnits, EOrbitalResourceType& OutResourceType, float& OutUnitVolume, int32& OutCreditValue, bool& bOutRecoveredBlackBox)
 {
 	bOutRecoveredBlackBox = false;
@@ -35,10 +67,7 @@ float AOrbitalResourceNode::ExtractResource(float RequestedUnits, EOrbitalResour
 		return 0.0f;
 	}
 
-	const float EffectiveRequest = RequestedUnits / FMath::Max(MiningResistance, 0.25f);
-	const float Extracted = FMath::Min(EffectiveRequest, ResourceUnitsRemaining);
-
-	ResourceUnitsRemaining -= Extracted;
+	const float Extracted = FOrbitalMiningRules::Extract(RequestedUnits, MiningResistance, ResourceUnitsRemaining);
 	OutResourceType = ResourceType;
 	OutUnitVolume = UnitVolume;
 	OutCreditValue = UnitCreditValue;
@@ -49,9 +78,16 @@ float AOrbitalResourceNode::ExtractResource(float RequestedUnits, EOrbitalResour
 		bContainsBlackBox = false;
 	}
 
-	if (ResourceUnitsRemaining <= KINDA_SMALL_NUMBER)
+	if (FOrbitalMiningRules::IsDepleted(ResourceUnitsRemaining))
 	{
-		Destroy();
+		if (UOrbitalActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UOrbitalActorPoolSubsystem>())
+		{
+			Pool->ReleaseActor(this);
+		}
+		else
+		{
+			Destroy();
+		}
 	}
 
 	return Extracted;
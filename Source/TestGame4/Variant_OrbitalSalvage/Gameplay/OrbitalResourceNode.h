@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "OrbitalTypes.h"
+#include "OrbitalActorPoolSubsystem.h"
 #include "OrbitalResourceNode.generated.h"
 
 class UStaticMeshComponent;
@@ -13,13 +14,18 @@ class UStaticMeshComponent;
  * Harvestable asteroid/wreck node for mining and salvage.
  */
 UCLASS()
-class AOrbitalResourceNode : public AActor
+class AOrbitalResourceNode : public AActor, public IOrbitalPooledActor
 {
 	GENERATED_BODY()
 
 public:
 	AOrbitalResourceNode();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UStaticMeshComponent* MeshComponent;
 
@@ -1,36 +1,106 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OrbitalSectorManager.h"
-#include "OrbitalResourceNode.h"
+#include "OrbitalResourceField.h"
 #include "OrbitalStationActor.h"
 #include "OrbitalJumpGateActor.h"
-#include "OrbitalEnemyDrone.h"
+#include "OrbitalActorPoolSubsystem.h"
+#include "TestGame4.h"
+#include "Async/Async.h"
 #include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sector Streaming"), STAT_OrbitalSectorStreaming, STATGROUP_OrbitalSalvage);
+DECLARE_CYCLE_STAT(TEXT("Sector Layout Build"), STAT_OrbitalSectorLayoutBuild, STATGROUP_OrbitalSalvage);
 
 AOrbitalSectorManager::AOrbitalSectorManager()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AOrbitalSectorManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (bRandomizeLayoutSeed)
+	{
+		LayoutSeed = FMath::Rand();
+	}
+}
+
+void AOrbitalSectorManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	UpdatePrefetch();
+	TickStreaming();
+}
+
+void AOrbitalSectorManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (PrefetchFuture.IsValid())
+	{
+		PrefetchFuture.Wait();
+		PrefetchFuture.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AOrbitalSectorManager::LoadSector(EOrbitalSectorId SectorId)
 {
-	ClearSpawnedActors();
+	ReleaseSpawnedActors();
 	PrimaryStation = nullptr;
 	ExtractionBeacon = nullptr;
 	JumpGate = nullptr;
 
-	switch (SectorId)
+	UE_LOG(LogTestGame4, Log, TEXT("Loading sector %s with layout seed %d"), *UEnum::GetValueAsString(SectorId), LayoutSeed);
+
+	const FOrbitalSectorSpawnList& Layout = FindOrBuildLayout(SectorId);
+	StreamingSectorId = SectorId;
+	NextResourceNode = 0;
+	NextDrone = 0;
+
+	// Stations and gates are few and gameplay-critical, so they exist as soon as the load returns.
+	SpawnStructures(Layout);
+	bStreamingIn = Layout.ResourceNodes.Num() > 0 || Layout.DroneLocations.Num() > 0;
+}
+
+void AOrbitalSectorManager::PrefetchSector(EOrbitalSectorId SectorId)
+{
+	if (LayoutCache.Contains(SectorId) || (PrefetchFuture.IsValid() && PrefetchSectorId == SectorId))
 	{
-	case EOrbitalSectorId::Belt:
-		SpawnBeltSector();
-		break;
-	case EOrbitalSectorId::Ruins:
-		SpawnRuinsSector();
-		break;
-	default:
-		SpawnBeltSector();
-		break;
+		return;
+	}
+
+	if (PrefetchFuture.IsValid())
+	{
+		PrefetchFuture.Wait();
+	}
+
+	PrefetchSectorId = SectorId;
+
+	const int32 Seed = LayoutSeed;
+	const FOrbitalSectorGenerationParams Params = MakeGenerationParams(SectorId);
+
+	PrefetchFuture = Async(EAsyncExecution::ThreadPool, [SectorId, Seed, Params]()
+	{
+		return FOrbitalSectorGenerator::Generate(SectorId, Seed, Params);
+	});
+}
+
+void AOrbitalSectorManager::SetLayoutSeed(int32 NewSeed)
+{
+	if (PrefetchFuture.IsValid())
+	{
+		PrefetchFuture.Wait();
+		PrefetchFuture.Reset();
 	}
+
+	LayoutSeed = NewSeed;
+	LayoutCache.Reset();
 }
 
 FVector AOrbitalSectorManager::GetSectorSpawnPoint(EOrbitalSectorId SectorId) const
@@ -46,127 +116,194 @@ FVector AOrbitalSectorManager::GetSectorSpawnPoint(EOrbitalSectorId SectorId) co
 	}
 }
 
-void AOrbitalSectorManager::ClearSpawnedActors()
+FVector AOrbitalSectorManager::GetSectorCenter(EOrbitalSectorId SectorId) const
 {
-	for (AActor* SpawnedActor : SpawnedActors)
+	return SectorId == EOrbitalSectorId::Ruins ? RuinsCenter : BeltCenter;
+}
+
+FOrbitalSectorGenerationParams AOrbitalSectorManager::MakeGenerationParams(EOrbitalSectorId SectorId) const
+{
+	FOrbitalSectorGenerationParams Params;
+	Params.Center = GetSectorCenter(SectorId);
+	Params.FieldRadius = FieldRadius;
+	Params.MinNodeSpacing = MinNodeSpacing;
+	Params.MinDroneSpacing = MinDroneSpacing;
+	return Params;
+}
+
+const FOrbitalSectorSpawnList& AOrbitalSectorManager::FindOrBuildLayout(EOrbitalSectorId SectorId)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSectorLayoutBuild);
+
+	if (PrefetchFuture.IsValid())
 	{
-		if (IsValid(SpawnedActor))
+		// Usually already finished by the time the ship reaches the gate; otherwise only the remainder is waited on.
+		FOrbitalSectorSpawnList Prefetched = PrefetchFuture.Get();
+		PrefetchFuture.Reset();
+
+		if (Prefetched.Seed == LayoutSeed)
 		{
-			SpawnedActor->Destroy();
+			LayoutCache.Add(Prefetched.SectorId, MoveTemp(Prefetched));
 		}
 	}
-	SpawnedActors.Empty();
+
+	if (const FOrbitalSectorSpawnList* Cached = LayoutCache.Find(SectorId))
+	{
+		return *Cached;
+	}
+
+	return LayoutCache.Add(SectorId, FOrbitalSectorGenerator::Generate(SectorId, LayoutSeed, MakeGenerationParams(SectorId)));
 }
 
-void AOrbitalSectorManager::SpawnBeltSector()
+void AOrbitalSectorManager::UpdatePrefetch()
 {
-	UWorld* World = GetWorld();
-	if (!World)
+	if (!JumpGate || LayoutCache.Contains(JumpGate->TargetSector) || (PrefetchFuture.IsValid() && PrefetchSectorId == JumpGate->TargetSector))
 	{
 		return;
 	}
 
-	PrimaryStation = World->SpawnActor<AOrbitalStationActor>(AOrbitalStationActor::StaticClass(), BeltCenter, FRotator::ZeroRotator);
-	if (PrimaryStation)
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!PlayerPawn)
 	{
-		PrimaryStation->bIsExtractionBeacon = false;
-		SpawnedActors.Add(PrimaryStation);
+		return;
 	}
 
-	JumpGate = World->SpawnActor<AOrbitalJumpGateActor>(AOrbitalJumpGateActor::StaticClass(), BeltCenter + FVector(7500.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
-	if (JumpGate)
+	if (FVector::DistSquared2D(PlayerPawn->GetActorLocation(), JumpGate->GetActorLocation()) <= FMath::Square(PrefetchRange))
 	{
-		JumpGate->TargetSector = EOrbitalSectorId::Ruins;
-		SpawnedActors.Add(JumpGate);
+		PrefetchSector(JumpGate->TargetSector);
 	}
-
-	SpawnResourceField(BeltCenter, 20, 6, true);
-	SpawnEnemyDrones(BeltCenter + FVector(3500.0f, 2200.0f, 0.0f), 2);
 }
 
-void AOrbitalSectorManager::SpawnRuinsSector()
+void AOrbitalSectorManager::TickStreaming()
 {
-	UWorld* World = GetWorld();
-	if (!World)
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSectorStreaming);
+
+	const FOrbitalSectorSpawnList* StreamingList = bStreamingIn ? LayoutCache.Find(StreamingSectorId) : nullptr;
+	if (!StreamingList)
 	{
+		bStreamingIn = false;
 		return;
 	}
 
-	ExtractionBeacon = World->SpawnActor<AOrbitalStationActor>(AOrbitalStationActor::StaticClass(), RuinsCenter, FRotator::ZeroRotator);
-	if (ExtractionBeacon)
+	const double Deadline = FPlatformTime::Seconds() + StreamingBudgetMs * 0.001;
+
+	while (bStreamingIn && FPlatformTime::Seconds() < Deadline)
+	{
+		if (NextResourceNode < StreamingList->ResourceNodes.Num())
+		{
+			const int32 BatchCount = FMath::Min(FMath::Max(ResourceNodesPerBatch, 1), StreamingList->ResourceNodes.Num() - NextResourceNode);
+			SpawnResourceField(TConstArrayView<FOrbitalResourceNodeSpawn>(StreamingList->ResourceNodes).Slice(NextResourceNode, BatchCount));
+			NextResourceNode += BatchCount;
+		}
+		else if (NextDrone < StreamingList->DroneLocations.Num())
+		{
+			const int32 BatchCount = FMath::Min(FMath::Max(DronesPerBatch, 1), StreamingList->DroneLocations.Num() - NextDrone);
+			SpawnEnemyDrones(TConstArrayView<FVector>(StreamingList->DroneLocations).Slice(NextDrone, BatchCount));
+			NextDrone += BatchCount;
+		}
+		else
+		{
+			bStreamingIn = false;
+		}
+	}
+}
+
+void AOrbitalSectorManager::ReleaseSpawnedActors()
+{
+	UOrbitalActorPoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UOrbitalActorPoolSubsystem>() : nullptr;
+
+	for (AActor* SpawnedActor : SpawnedActors)
+	{
+		if (!IsValid(SpawnedActor))
+		{
+			continue;
+		}
+
+		if (Pool)
+		{
+			Pool->ReleaseActor(SpawnedActor);
+		}
+		else
+		{
+			SpawnedActor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+
+	if (ResourceField)
 	{
-		ExtractionBeacon->bIsExtractionBeacon = true;
-		SpawnedActors.Add(ExtractionBeacon);
+		ResourceField->ClearField();
 	}
 
-	JumpGate = World->SpawnActor<AOrbitalJumpGateActor>(AOrbitalJumpGateActor::StaticClass(), RuinsCenter + FVector(-7600.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
-	if (JumpGate)
+	if (DroneSwarm)
 	{
-		JumpGate->TargetSector = EOrbitalSectorId::Belt;
-		SpawnedActors.Add(JumpGate);
+		DroneSwarm->ClearSwarm();
 	}
 
-	SpawnResourceField(RuinsCenter, 12, 10, false);
-	SpawnEnemyDrones(RuinsCenter + FVector(1800.0f, 1200.0f, 0.0f), 5);
+	bStreamingIn = false;
 }
 
-void AOrbitalSectorManager::SpawnResourceField(const FVector& Center, int32 AsteroidCount, int32 WreckCount, bool bIncludeMissionWreck)
+void AOrbitalSectorManager::SpawnStructures(const FOrbitalSectorSpawnList& SpawnList)
 {
-	UWorld* World = GetWorld();
-	if (!World)
+	UOrbitalActorPoolSubsystem* Pool = GetWorld() ? GetWorld()->GetSubsystem<UOrbitalActorPoolSubsystem>() : nullptr;
+	if (!Pool)
 	{
 		return;
 	}
 
-	auto SpawnNode = [&](EOrbitalResourceNodeKind Kind, EOrbitalResourceType Type, float Units, float RadiusScale, bool bBlackBox)
+	for (const FOrbitalStationSpawn& StationSpawn : SpawnList.Stations)
 	{
-		const FVector RandOffset = FVector(
-			FMath::FRandRange(-FieldRadius, FieldRadius),
-			FMath::FRandRange(-FieldRadius, FieldRadius),
-			0.0f
-		);
-
-		AOrbitalResourceNode* Node = World->SpawnActor<AOrbitalResourceNode>(AOrbitalResourceNode::StaticClass(), Center + RandOffset, FRotator::ZeroRotator);
-		if (Node)
+		AOrbitalStationActor* Station = Pool->Acquire<AOrbitalStationActor>(StationSpawn.Location);
+		if (Station)
 		{
-			Node->NodeKind = Kind;
-			Node->ResourceType = Type;
-			Node->ResourceUnitsRemaining = Units;
-			Node->bContainsBlackBox = bBlackBox;
+			Station->bIsExtractionBeacon = StationSpawn.bIsExtractionBeacon;
+			SpawnedActors.Add(Station);
 
-			if (Kind == EOrbitalResourceNodeKind::Asteroid)
+			if (StationSpawn.bIsExtractionBeacon)
 			{
-				Node->UnitVolume = 1.5f;
-				Node->UnitCreditValue = 16;
-				Node->MiningResistance = 1.2f;
+				ExtractionBeacon = Station;
 			}
 			else
 			{
-				Node->UnitVolume = 1.0f;
-				Node->UnitCreditValue = 24;
-				Node->MiningResistance = 0.9f;
+				PrimaryStation = Station;
 			}
+		}
+	}
 
-			Node->SetActorScale3D(FVector(RadiusScale));
-			SpawnedActors.Add(Node);
+	for (const FOrbitalJumpGateSpawn& GateSpawn : SpawnList.JumpGates)
+	{
+		AOrbitalJumpGateActor* Gate = Pool->Acquire<AOrbitalJumpGateActor>(GateSpawn.Location);
+		if (Gate)
+		{
+			Gate->TargetSector = GateSpawn.TargetSector;
+			SpawnedActors.Add(Gate);
+			JumpGate = Gate;
 		}
-	};
+	}
+}
 
-	for (int32 i = 0; i < AsteroidCount; ++i)
+void AOrbitalSectorManager::SpawnResourceField(TConstArrayView<FOrbitalResourceNodeSpawn> Nodes)
+{
+	UWorld* World = GetWorld();
+	if (!World)
 	{
-		SpawnNode(EOrbitalResourceNodeKind::Asteroid, EOrbitalResourceType::Ore, FMath::FRandRange(180.0f, 360.0f), FMath::FRandRange(1.6f, 3.0f), false);
+		return;
 	}
 
-	bool bMissionNodeSpawned = false;
-	for (int32 i = 0; i < WreckCount; ++i)
+	if (!ResourceField)
 	{
-		const bool bMissionNode = bIncludeMissionWreck && !bMissionNodeSpawned && i == 0;
-		SpawnNode(EOrbitalResourceNodeKind::Wreck, EOrbitalResourceType::Salvage, FMath::FRandRange(80.0f, 190.0f), FMath::FRandRange(1.1f, 2.0f), bMissionNode);
-		bMissionNodeSpawned |= bMissionNode;
+		INC_DWORD_STAT(STAT_OrbitalActorsSpawned);
+		ResourceField = World->SpawnActor<AOrbitalResourceField>(AOrbitalResourceField::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+		if (!ResourceField)
+		{
+			return;
+		}
 	}
+
+	ResourceField->AddNodes(Nodes);
 }
 
-void AOrbitalSectorManager::SpawnEnemyDrones(const FVector& Center, int32 Count)
+void AOrbitalSectorManager::SpawnEnemyDrones(TConstArrayView<FVector> Locations)
 {
 	UWorld* World = GetWorld();
 	if (!World)
@@ -174,14 +311,15 @@ void AOrbitalSectorManager::SpawnEnemyDrones(const FVector& Center, int32 Count)
 		return;
 	}
 
-	for (int32 i = 0; i < Count; ++i)
+	if (!DroneSwarm)
 	{
-		const FVector Offset(FMath::FRandRange(-1500.0f, 1500.0f), FMath::FRandRange(-1500.0f, 1500.0f), 0.0f);
-		AOrbitalEnemyDrone* Drone = World->SpawnActor<AOrbitalEnemyDrone>(AOrbitalEnemyDrone::StaticClass(), Center + Offset, FRotator::ZeroRotator);
-		if (Drone)
+		INC_DWORD_STAT(STAT_OrbitalActorsSpawned);
+		DroneSwarm = World->SpawnActor<AOrbitalDroneSwarm>(AOrbitalDroneSwarm::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+		if (!DroneSwarm)
 		{
-			SpawnedActors.Add(Drone);
+			return;
 		}
 	}
-}
 
+	DroneSwarm->AddDrones(Locations);
+}
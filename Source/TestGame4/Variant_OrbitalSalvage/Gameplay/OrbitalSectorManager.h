@@ -4,16 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Async/Future.h"
 #include "OrbitalTypes.h"
+#include "OrbitalSectorGenerator.h"
+#include "OrbitalDroneSwarm.h"
 #include "OrbitalSectorManager.generated.h"
 
-class AOrbitalResourceNode;
+class AOrbitalResourceField;
 class AOrbitalStationActor;
 class AOrbitalJumpGateActor;
-class AOrbitalEnemyDrone;
 
 /**
  * Spawns and swaps active sector gameplay actors.
+ * Sector content is streamed: the spawn list is pre-built when the ship nears a jump gate,
+ * stations and gates appear on load, and the rest spawns under a per-frame time budget.
+ * Actors are drawn from and returned to UOrbitalActorPoolSubsystem rather than spawned and destroyed.
  */
 UCLASS()
 class AOrbitalSectorManager : public AActor
@@ -23,9 +28,24 @@ class AOrbitalSectorManager : public AActor
 public:
 	AOrbitalSectorManager();
 
+	virtual void PostInitializeComponents() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintCallable, Category="Sector")
 	void LoadSector(EOrbitalSectorId SectorId);
 
+	/** Starts building the spawn list for a sector in the background so a later LoadSector does not pay for it. */
+	UFUNCTION(BlueprintCallable, Category="Sector")
+	void PrefetchSector(EOrbitalSectorId SectorId);
+
+	/** Sets the seed every sector layout is generated from and drops layouts built with the previous seed. */
+	UFUNCTION(BlueprintCallable, Category="Sector")
+	void SetLayoutSeed(int32 NewSeed);
+
+	UFUNCTION(BlueprintPure, Category="Sector")
+	int32 GetLayoutSeed() const { return LayoutSeed; }
+
 	UFUNCTION(BlueprintPure, Category="Sector")
 	FVector GetSectorSpawnPoint(EOrbitalSectorId SectorId) const;
 
@@ -38,6 +58,15 @@ public:
 	UFUNCTION(BlueprintPure, Category="Sector")
 	AOrbitalJumpGateActor* GetJumpGate() const { return JumpGate; }
 
+	UFUNCTION(BlueprintPure, Category="Sector")
+	AOrbitalResourceField* GetResourceField() const { return ResourceField; }
+
+	UFUNCTION(BlueprintPure, Category="Sector")
+	AOrbitalDroneSwarm* GetDroneSwarm() const { return DroneSwarm; }
+
+	UFUNCTION(BlueprintPure, Category="Sector")
+	bool IsStreaming() const { return bStreamingIn; }
+
 private:
 	UPROPERTY()
 	TArray<TObjectPtr<AActor>> SpawnedActors;
@@ -51,6 +80,12 @@ private:
 	UPROPERTY()
 	TObjectPtr<AOrbitalJumpGateActor> JumpGate;
 
+	UPROPERTY()
+	TObjectPtr<AOrbitalResourceField> ResourceField;
+
+	UPROPERTY()
+	TObjectPtr<AOrbitalDroneSwarm> DroneSwarm;
+
 	UPROPERTY(EditAnywhere, Category="Sector")
 	FVector BeltCenter = FVector(0.0f, 0.0f, 240.0f);
 
@@ -60,11 +95,55 @@ private:
 	UPROPERTY(EditAnywhere, Category="Sector")
 	float FieldRadius = 9000.0f;
 
-	void ClearSpawnedActors();
-	void SpawnBeltSector();
-	void SpawnRuinsSector();
+	/** Seed for every sector layout. Identical seeds reproduce identical layouts. */
+	UPROPERTY(EditAnywhere, Category="Sector|Generation")
+	int32 LayoutSeed = 0;
 
-	void SpawnResourceField(const FVector& Center, int32 AsteroidCount, int32 WreckCount, bool bIncludeMissionWreck);
-	void SpawnEnemyDrones(const FVector& Center, int32 Count);
-};
+	/** Picks a fresh LayoutSeed when the manager is spawned. Disable to replay a specific seed. */
+	UPROPERTY(EditAnywhere, Category="Sector|Generation")
+	bool bRandomizeLayoutSeed = true;
+
+	UPROPERTY(EditAnywhere, Category="Sector|Generation")
+	float MinNodeSpacing = 900.0f;
+
+	UPROPERTY(EditAnywhere, Category="Sector|Generation")
+	float MinDroneSpacing = 300.0f;
+
+	/** Ship distance to the active jump gate at which the target sector starts prefetching. */
+	UPROPERTY(EditAnywhere, Category="Sector|Streaming")
+	float PrefetchRange = 4500.0f;
+
+	/** Game-thread time per frame spent bringing in new sector content. */
+	UPROPERTY(EditAnywhere, Category="Sector|Streaming")
+	float StreamingBudgetMs = 2.0f;
 
+	/** Resource nodes handed to the field per batch while streaming. */
+	UPROPERTY(EditAnywhere, Category="Sector|Streaming")
+	int32 ResourceNodesPerBatch = 128;
+
+	/** Drones handed to the swarm per batch while streaming. */
+	UPROPERTY(EditAnywhere, Category="Sector|Streaming")
+	int32 DronesPerBatch = 128;
+
+	/** Generated layouts by sector; valid for the current LayoutSeed. */
+	TMap<EOrbitalSectorId, FOrbitalSectorSpawnList> LayoutCache;
+
+	EOrbitalSectorId StreamingSectorId = EOrbitalSectorId::Belt;
+	int32 NextResourceNode = 0;
+	int32 NextDrone = 0;
+	bool bStreamingIn = false;
+
+	TFuture<FOrbitalSectorSpawnList> PrefetchFuture;
+	EOrbitalSectorId PrefetchSectorId = EOrbitalSectorId::Belt;
+
+	FVector GetSectorCenter(EOrbitalSectorId SectorId) const;
+	FOrbitalSectorGenerationParams MakeGenerationParams(EOrbitalSectorId SectorId) const;
+	const FOrbitalSectorSpawnList& FindOrBuildLayout(EOrbitalSectorId SectorId);
+	void UpdatePrefetch();
+	void TickStreaming();
+
+	void ReleaseSpawnedActors();
+	void SpawnStructures(const FOrbitalSectorSpawnList& SpawnList);
+	void SpawnResourceField(TConstArrayView<FOrbitalResourceNodeSpawn> Nodes);
+	void SpawnEnemyDrones(TConstArrayView<FVector> Locations);
+};
@@ -6,12 +6,20 @@
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Misc/ScopeLock.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
 #include "UObject/ConstructorHelpers.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ship Physics"), STAT_OrbitalShipPhysics, STATGROUP_OrbitalSalvage);
 
 AOrbitalShipPawn::AOrbitalShipPawn()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Thrust, brake and assist are applied as forces in the fixed physics step (see DefaultEngine.ini)
+	bAsyncPhysicsTickEnabled = true;
+
 	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 	RootComponent = SceneRoot;
 
@@ -23,6 +31,7 @@ AOrbitalShipPawn::AOrbitalShipPawn()
 	ShipMesh->SetEnableGravity(false);
 	ShipMesh->SetLinearDamping(0.2f);
 	ShipMesh->SetAngularDamping(1.0f);
+	ShipMesh->BodyInstance.DOFMode = EDOFMode::SixDOF;
 	ShipMesh->BodyInstance.bLockXRotation = true;
 	ShipMesh->BodyInstance.bLockYRotation = true;
 	ShipMesh->BodyInstance.bLockZTranslation = true;
@@ -59,6 +68,10 @@ AOrbitalShipPawn::AOrbitalShipPawn()
 
 void AOrbitalShipPawn::BeginPlay()
 {
+	// A simulating mesh may be detached from the actor at runtime, so take the offset from its template
+	const USceneComponent* MeshTemplate = Cast<USceneComponent>(ShipMesh->GetArchetype());
+	MeshToActorRotation = (MeshTemplate ? MeshTemplate->GetRelativeRotation() : ShipMesh->GetRelativeRotation()).Quaternion().Inverse();
+
 	Super::BeginPlay();
 	SetActorLocation(FVector(GetActorLocation().X, GetActorLocation().Y, 240.0f));
 }
@@ -66,7 +79,7 @@ void AOrbitalShipPawn::BeginPlay()
 void AOrbitalShipPawn::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
-	TickPhysics(DeltaSeconds);
+	ChargeFlightUsage();
 }
 
 void AOrbitalShipPawn::SetMoveInput(const FVector2D& InMoveInput)
@@ -102,63 +115,129 @@ float AOrbitalShipPawn::GetCurrentSpeed() const
 	return ShipMesh ? ShipMesh->GetPhysicsLinearVelocity().Size2D() : 0.0f;
 }
 
-void AOrbitalShipPawn::TickPhysics(float DeltaSeconds)
+void AOrbitalShipPawn::ChargeFlightUsage()
 {
-	if (!ShipMesh || !ShipSystems || !ShipSystems->IsAlive())
+	if (!ShipSystems)
 	{
 		return;
 	}
 
-	const float InputMagnitude = FMath::Clamp(MoveInput.Size() + FMath::Abs(TurnInput), 0.0f, 1.5f);
-	if (InputMagnitude > KINDA_SMALL_NUMBER)
+	FFlightControls Controls;
+	Controls.MoveInput = MoveInput;
+	Controls.TurnInput = TurnInput;
+	Controls.bBrake = bBrakeInput;
+	Controls.bAssist = bFlightAssistEnabled;
+	Controls.bAlive = ShipSystems->IsAlive();
+
+	float ThrustSeconds = 0.0f;
+	float BrakeSeconds = 0.0f;
+	{
+		FScopeLock Lock(&FlightLock);
+		ThrustSeconds = PendingThrustSeconds;
+		BrakeSeconds = PendingBrakeSeconds;
+		PendingThrustSeconds = 0.0f;
+		PendingBrakeSeconds = 0.0f;
+	}
+
+	// The systems are charged once per frame for everything the physics steps flew since the last one, so
+	// the thrusters cut out a frame after fuel or power runs dry rather than mid-step.
+	if (ThrustSeconds > 0.0f)
+	{
+		const bool bHasFuel = ShipSystems->ConsumeFuel(ThrustFuelCostPerSecond * ThrustSeconds);
+		const bool bHasPower = ShipSystems->ConsumePower(ThrusterPowerCostPerSecond * ThrustSeconds);
+		Controls.bThrustersAvailable = bHasFuel && bHasPower;
+	}
+	else
+	{
+		Controls.bThrustersAvailable = ShipSystems->Fuel > 0.0f && ShipSystems->GetCurrentPower() > 0.0f;
+	}
+
+	if (BrakeSeconds > 0.0f)
 	{
-		const float FuelCost = ThrustFuelCostPerSecond * InputMagnitude * DeltaSeconds;
-		const float PowerCost = ThrusterPowerCostPerSecond * InputMagnitude * DeltaSeconds;
+		ShipSystems->AddHeat(4.0f * BrakeSeconds);
+	}
 
-		const bool bHasFuel = ShipSystems->ConsumeFuel(FuelCost);
-		const bool bHasPower = ShipSystems->ConsumePower(PowerCost);
+	FScopeLock Lock(&FlightLock);
+	FlightControls = Controls;
+}
 
-		if (bHasFuel && bHasPower)
-		{
-			const FVector ForwardForce = GetActorForwardVector() * MoveInput.Y * ForwardThrustForce;
-			const FVector StrafeForce = GetActorRightVector() * MoveInput.X * StrafeThrustForce;
-			ShipMesh->AddForce(ForwardForce + StrafeForce);
+void AOrbitalShipPawn::AsyncPhysicsTickActor(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickActor(DeltaTime, SimTime);
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalShipPhysics);
 
-			const FVector TorqueVector = FVector(0.0f, 0.0f, TurnInput * TurnTorque);
-			ShipMesh->AddTorqueInRadians(TorqueVector);
-		}
+	if (!ShipMesh || DeltaTime <= 0.0f)
+	{
+		return;
 	}
 
-	if (bBrakeInput)
+	FBodyInstanceAsyncPhysicsTickHandle Body = ShipMesh->GetBodyInstanceAsyncPhysicsTickHandle();
+	if (!Body.IsValid())
 	{
-		const FVector Velocity = ShipMesh->GetPhysicsLinearVelocity();
-		const FVector BrakeVector = -Velocity.GetSafeNormal2D() * BrakeForce;
-		ShipMesh->AddForce(BrakeVector);
-		ShipSystems->AddHeat(4.0f * DeltaSeconds);
+		return;
 	}
 
-	if (bFlightAssistEnabled)
+	FFlightControls Controls;
 	{
-		const FVector Vel = ShipMesh->GetPhysicsLinearVelocity();
-		ShipMesh->AddForce(-Vel * AssistLinearDamping * ShipMesh->GetMass());
+		FScopeLock Lock(&FlightLock);
+		Controls = FlightControls;
+	}
 
-		const FVector AngularVel = ShipMesh->GetPhysicsAngularVelocityInRadians();
-		ShipMesh->AddTorqueInRadians(-AngularVel * AssistAngularDamping * ShipMesh->GetMass());
+	if (!Controls.bAlive)
+	{
+		return;
 	}
 
-	FVector ClampedVelocity = ShipMesh->GetPhysicsLinearVelocity();
-	const float Speed = ClampedVelocity.Size2D();
+	// Runs on the physics thread at the fixed async step: everything here acts on the solver's body directly,
+	// and the flight plane is held by the body's Z lock.
+	const float Mass = FMath::Max(static_cast<float>(Body->M()), KINDA_SMALL_NUMBER);
+	const FQuat ActorRotation = FQuat(Body->R()) * MeshToActorRotation;
+	FVector Velocity = Body->V();
+	const float YawRate = Body->W().Z;
+
+	float Speed = Velocity.Size2D();
 	if (Speed > MaxSpeed)
 	{
-		const FVector FlatVel = FVector(ClampedVelocity.X, ClampedVelocity.Y, 0.0f).GetSafeNormal() * MaxSpeed;
-		ClampedVelocity.X = FlatVel.X;
-		ClampedVelocity.Y = FlatVel.Y;
-		ShipMesh->SetPhysicsLinearVelocity(ClampedVelocity);
+		Velocity *= MaxSpeed / Speed;
+		Speed = MaxSpeed;
+		Body->SetV(Velocity);
 	}
 
-	// Keep ship on 2D flight plane.
-	FVector Location = GetActorLocation();
-	Location.Z = 240.0f;
-	SetActorLocation(Location);
-}
+	FVector Force = FVector::ZeroVector;
+	float Torque = 0.0f;
+	float ThrustSeconds = 0.0f;
+
+	const float InputMagnitude = FMath::Clamp(Controls.MoveInput.Size() + FMath::Abs(Controls.TurnInput), 0.0f, 1.5f);
+	if (InputMagnitude > KINDA_SMALL_NUMBER && Controls.bThrustersAvailable)
+	{
+		// The body carries the mesh's relative yaw; thrust follows the actor's forward and right vectors.
+		const FRotator Heading(0.0f, ActorRotation.Rotator().Yaw, 0.0f);
+		Force += Heading.Vector() * Controls.MoveInput.Y * ForwardThrustForce;
+		Force += FRotationMatrix(Heading).GetUnitAxis(EAxis::Y) * Controls.MoveInput.X * StrafeThrustForce;
+		Torque += Controls.TurnInput * TurnTorque;
+		ThrustSeconds = InputMagnitude * DeltaTime;
+	}
+
+	if (Controls.bBrake)
+	{
+		// Never let the brake reverse the ship within a single step.
+		const float BrakeMagnitude = FMath::Min(BrakeForce, Speed * Mass / DeltaTime);
+		Force -= Velocity.GetSafeNormal2D() * BrakeMagnitude;
+	}
+
+	if (Controls.bAssist)
+	{
+		Force -= Velocity * AssistLinearDamping * Mass;
+		Torque -= YawRate * AssistAngularDamping * Mass;
+	}
 
+	Body->AddForce(FVector(Force.X, Force.Y, 0.0f));
+	Body->AddTorque(FVector(0.0f, 0.0f, Torque));
+
+	if (ThrustSeconds > 0.0f || Controls.bBrake)
+	{
+		FScopeLock Lock(&FlightLock);
+		PendingThrustSeconds += ThrustSeconds;
+		PendingBrakeSeconds += Controls.bBrake ? DeltaTime : 0.0f;
+	}
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "HAL/CriticalSection.h"
 #include "OrbitalShipPawn.generated.h"
 
 class UCameraComponent;
@@ -26,6 +27,7 @@ public:
 
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void AsyncPhysicsTickActor(float DeltaTime, float SimTime) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	USceneComponent* SceneRoot;
@@ -112,5 +114,30 @@ private:
 	float TurnInput = 0.0f;
 	bool bBrakeInput = false;
 
-	void TickPhysics(float DeltaSeconds);
+	/** Game thread state the physics step flies by, copied across once per frame */
+	struct FFlightControls
+	{
+		FVector2D MoveInput = FVector2D::ZeroVector;
+		float TurnInput = 0.0f;
+		bool bBrake = false;
+		bool bAssist = true;
+		bool bThrustersAvailable = true;
+		bool bAlive = true;
+	};
+
+	/**
+	 * Rotation that takes ShipMesh's body rotation back to the actor's, i.e. the inverse of the mesh's authored
+	 * relative rotation. Set in BeginPlay before the async physics tick starts and read-only afterwards.
+	 */
+	FQuat MeshToActorRotation = FQuat::Identity;
+
+	/** Guards FlightControls and the pending usage below, shared between the game and physics threads */
+	FCriticalSection FlightLock;
+	FFlightControls FlightControls;
+
+	/** Throttle-weighted thrust and brake time flown by the physics step since the systems were last charged */
+	float PendingThrustSeconds = 0.0f;
+	float PendingBrakeSeconds = 0.0f;
+
+	void ChargeFlightUsage();
 };
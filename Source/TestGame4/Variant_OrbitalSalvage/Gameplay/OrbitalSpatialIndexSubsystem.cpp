@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalSpatialIndexSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Query"), STAT_OrbitalSpatialQuery, STATGROUP_OrbitalSalvage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spatial Queries"), STAT_OrbitalSpatialQueries, STATGROUP_OrbitalSalvage);
+
+void UOrbitalSpatialIndexSubsystem::Deinitialize()
+{
+	Cells.Empty();
+	ActorCells.Empty();
+	MaxInteractionRange = 0.0f;
+
+	Super::Deinitialize();
+}
+
+void UOrbitalSpatialIndexSubsystem::RegisterActor(AActor* Actor, float InteractionRange)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	if (ActorCells.Contains(Actor))
+	{
+		UpdateActorLocation(Actor);
+	}
+	else
+	{
+		const FVector Location = Actor->GetActorLocation();
+		const FIntPoint Cell = ToCell(Location);
+		Cells.FindOrAdd(Cell).Add({ Actor, FVector2D(Location) });
+		ActorCells.Add(Actor, Cell);
+	}
+
+	MaxInteractionRange = FMath::Max(MaxInteractionRange, InteractionRange);
+}
+
+void UOrbitalSpatialIndexSubsystem::UnregisterActor(AActor* Actor)
+{
+	FIntPoint Cell;
+	if (ActorCells.RemoveAndCopyValue(Actor, Cell))
+	{
+		RemoveFromCell(Cell, Actor);
+	}
+}
+
+void UOrbitalSpatialIndexSubsystem::UpdateActorLocation(AActor* Actor)
+{
+	FIntPoint* CurrentCell = ActorCells.Find(Actor);
+	if (!CurrentCell || !IsValid(Actor))
+	{
+		return;
+	}
+
+	const FVector Location = Actor->GetActorLocation();
+	const FIntPoint NewCell = ToCell(Location);
+
+	if (NewCell == *CurrentCell)
+	{
+		for (FEntry& Entry : Cells.FindChecked(NewCell))
+		{
+			if (Entry.Actor.Get() == Actor)
+			{
+				Entry.Location = FVector2D(Location);
+				break;
+			}
+		}
+		return;
+	}
+
+	RemoveFromCell(*CurrentCell, Actor);
+	Cells.FindOrAdd(NewCell).Add({ Actor, FVector2D(Location) });
+	*CurrentCell = NewCell;
+}
+
+void UOrbitalSpatialIndexSubsystem::QueryActorsInRadius(const FVector& Center, float Radius, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSpatialQuery);
+	INC_DWORD_STAT(STAT_OrbitalSpatialQueries);
+
+	OutActors.Reset();
+
+	UClass* FilterClass = ActorClass ? ActorClass.Get() : AActor::StaticClass();
+	ForEachInRadius<AActor>(Center, Radius, [&](AActor* Candidate, float DistSq)
+	{
+		if (Candidate->IsA(FilterClass))
+		{
+			OutActors.Add(Candidate);
+		}
+	});
+}
+
+FIntPoint UOrbitalSpatialIndexSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UOrbitalSpatialIndexSubsystem::RemoveFromCell(const FIntPoint& Cell, const AActor* Actor)
+{
+	TArray<FEntry>* Entries = Cells.Find(Cell);
+	if (!Entries)
+	{
+		return;
+	}
+
+	Entries->RemoveAllSwap([Actor](const FEntry& Entry)
+	{
+		return Entry.Actor.Get() == Actor || !Entry.Actor.IsValid();
+	});
+
+	if (Entries->Num() == 0)
+	{
+		Cells.Remove(Cell);
+	}
+}
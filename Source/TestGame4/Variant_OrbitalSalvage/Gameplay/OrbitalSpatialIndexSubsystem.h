@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OrbitalSpatialIndexSubsystem.generated.h"
+
+/**
+ * Uniform-grid spatial hash over the Orbital interactables (stations, jump gates, resource nodes).
+ * Actors register themselves on BeginPlay and unregister on EndPlay; queries only touch the cells
+ * overlapping the search radius instead of iterating every actor in the world.
+ */
+UCLASS()
+class UOrbitalSpatialIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterActor(AActor* Actor, float InteractionRange = 0.0f);
+	void UnregisterActor(AActor* Actor);
+
+	/** Re-buckets an already registered actor after it has been moved. */
+	void UpdateActorLocation(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category="Orbital|Spatial")
+	void QueryActorsInRadius(const FVector& Center, float Radius, TSubclassOf<AActor> ActorClass, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintPure, Category="Orbital|Spatial")
+	float GetMaxInteractionRange() const { return MaxInteractionRange; }
+
+	UFUNCTION(BlueprintPure, Category="Orbital|Spatial")
+	int32 GetNumIndexedActors() const { return ActorCells.Num(); }
+
+	/** Visits every indexed actor of type T whose 2D distance to Center is within Radius. */
+	template<typename T, typename FunctorType>
+	void ForEachInRadius(const FVector& Center, float Radius, FunctorType&& Func) const
+	{
+		const float RadiusSq = FMath::Square(Radius);
+		const FIntPoint MinCell = ToCell(Center - FVector(Radius, Radius, 0.0f));
+		const FIntPoint MaxCell = ToCell(Center + FVector(Radius, Radius, 0.0f));
+
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+			{
+				const TArray<FEntry>* Entries = Cells.Find(FIntPoint(CellX, CellY));
+				if (!Entries)
+				{
+					continue;
+				}
+
+				for (const FEntry& Entry : *Entries)
+				{
+					T* Typed = Cast<T>(Entry.Actor.Get());
+					if (!Typed)
+					{
+						continue;
+					}
+
+					const float DistSq = FVector2D::DistSquared(Entry.Location, FVector2D(Center));
+					if (DistSq <= RadiusSq)
+					{
+						Func(Typed, DistSq);
+					}
+				}
+			}
+		}
+	}
+
+	/** Returns the closest indexed actor of type T within Radius that passes Predicate. */
+	template<typename T, typename PredicateType>
+	T* FindNearestInRadius(const FVector& Center, float Radius, PredicateType&& Predicate) const
+	{
+		T* Best = nullptr;
+		float BestDistSq = TNumericLimits<float>::Max();
+
+		ForEachInRadius<T>(Center, Radius, [&](T* Candidate, float DistSq)
+		{
+			if (DistSq < BestDistSq && Predicate(Candidate))
+			{
+				BestDistSq = DistSq;
+				Best = Candidate;
+			}
+		});
+
+		return Best;
+	}
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector2D Location;
+	};
+
+	float CellSize = 2500.0f;
+
+	float MaxInteractionRange = 0.0f;
+
+	TMap<FIntPoint, TArray<FEntry>> Cells;
+	TMap<TWeakObjectPtr<AActor>, FIntPoint> ActorCells;
+
+	FIntPoint ToCell(const FVector& Location) const;
+	void RemoveFromCell(const FIntPoint& Cell, const AActor* Actor);
+};
@@ -2,6 +2,7 @@
 
 #include "OrbitalStationActor.h"
 #include "OrbitalShipPawn.h"
+#include "OrbitalSpatialIndexSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "UObject/ConstructorHelpers.h"
@@ -30,6 +31,36 @@ AOrbitalStationActor::AOrbitalStationActor()
 	DockRangeSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
+void AOrbitalStationActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnAcquiredFromPool();
+}
+
+void AOrbitalStationActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OnReturnedToPool();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOrbitalStationActor::OnAcquiredFromPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->RegisterActor(this, DockRange);
+	}
+}
+
+void AOrbitalStationActor::OnReturnedToPool()
+{
+	if (UOrbitalSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UOrbitalSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterActor(this);
+	}
+}
+
 bool AOrbitalStationActor::CanDockShip(const AOrbitalShipPawn* Ship) const
 {
 	if (!Ship)
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OrbitalActorPoolSubsystem.h"
 #include "OrbitalStationActor.generated.h"
 
 class UStaticMeshComponent;
@@ -14,13 +15,18 @@ class AOrbitalShipPawn;
  * Dock target for trade/repair/refuel and extraction.
  */
 UCLASS()
-class AOrbitalStationActor : public AActor
+class AOrbitalStationActor : public AActor, public IOrbitalPooledActor
 {
 	GENERATED_BODY()
 
 public:
 	AOrbitalStationActor();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	UStaticMeshComponent* MeshComponent;
 
@@ -45,3 +45,21 @@ enum class EOrbitalResourceNodeKind : uint8
 	Wreck		UMETA(DisplayName = "Wreck")
 };
 
+UENUM(BlueprintType)
+enum class EOrbitalDroneLod : uint8
+{
+	Active		UMETA(DisplayName = "Active"),
+	Idle		UMETA(DisplayName = "Idle"),
+	Dormant		UMETA(DisplayName = "Dormant")
+};
+
+UENUM(BlueprintType)
+enum class EOrbitalShipThreshold : uint8
+{
+	PowerFull		UMETA(DisplayName = "Power Full"),
+	PowerDepleted	UMETA(DisplayName = "Power Depleted"),
+	OverheatStarted	UMETA(DisplayName = "Overheat Started"),
+	OverheatEnded	UMETA(DisplayName = "Overheat Ended"),
+	HeatCleared		UMETA(DisplayName = "Heat Cleared"),
+	HullDestroyed	UMETA(DisplayName = "Hull Destroyed")
+};
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalSectorGenerator.h"
+#include "TestGame4.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sector Generate"), STAT_OrbitalSectorGenerate, STATGROUP_OrbitalSalvage);
+
+FOrbitalSectorSpawnList FOrbitalSectorGenerator::Generate(EOrbitalSectorId SectorId, int32 Seed, const FOrbitalSectorGenerationParams& Params)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalSectorGenerate);
+
+	FOrbitalSectorSpawnList SpawnList;
+	SpawnList.SectorId = SectorId;
+	SpawnList.Seed = Seed;
+
+	FRandomStream Stream(MakeSectorSeed(SectorId, Seed));
+	const FVector& Center = Params.Center;
+
+	switch (SectorId)
+	{
+	case EOrbitalSectorId::Ruins:
+		SpawnList.Stations.Add({ Center, true });
+		SpawnList.JumpGates.Add({ Center + FVector(-7600.0f, 0.0f, 0.0f), EOrbitalSectorId::Belt });
+		GenerateResourceField(Stream, Params, 12, 10, false, SpawnList.ResourceNodes);
+		GenerateEnemyDrones(Stream, Params, Center + FVector(1800.0f, 1200.0f, 0.0f), 5, SpawnList.DroneLocations);
+		break;
+	case EOrbitalSectorId::Belt:
+	default:
+		SpawnList.Stations.Add({ Center, false });
+		SpawnList.JumpGates.Add({ Center + FVector(7500.0f, 0.0f, 0.0f), EOrbitalSectorId::Ruins });
+		GenerateResourceField(Stream, Params, 20, 6, true, SpawnList.ResourceNodes);
+		GenerateEnemyDrones(Stream, Params, Center + FVector(3500.0f, 2200.0f, 0.0f), 2, SpawnList.DroneLocations);
+		break;
+	}
+
+	return SpawnList;
+}
+
+int32 FOrbitalSectorGenerator::MakeSectorSeed(EOrbitalSectorId SectorId, int32 Seed)
+{
+	return static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(static_cast<uint8>(SectorId))));
+}
+
+void FOrbitalSectorGenerator::SamplePoissonDisk(FRandomStream& Stream, const FVector2D& Center, float HalfExtent, float MinSpacing, int32 Count, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset(Count);
+
+	if (Count <= 0 || HalfExtent <= 0.0f)
+	{
+		return;
+	}
+
+	const float Extent = HalfExtent * 2.0f;
+	const FVector2D Origin = Center - FVector2D(HalfExtent, HalfExtent);
+
+	if (MinSpacing <= 0.0f)
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutPoints.Add(Origin + FVector2D(Stream.FRandRange(0.0f, Extent), Stream.FRandRange(0.0f, Extent)));
+		}
+		return;
+	}
+
+	// Cells of MinSpacing/sqrt(2) hold at most one point, so a candidate only has to be checked against a 5x5 block.
+	const float CellSize = MinSpacing / UE_SQRT_2;
+	const int32 GridDim = FMath::Max(1, FMath::CeilToInt(Extent / CellSize));
+	const float MinSpacingSq = FMath::Square(MinSpacing);
+
+	TArray<int32> Grid;
+	Grid.Init(INDEX_NONE, GridDim * GridDim);
+
+	const int32 MaxAttempts = Count * 30;
+	for (int32 Attempt = 0; Attempt < MaxAttempts && OutPoints.Num() < Count; ++Attempt)
+	{
+		const FVector2D Local(Stream.FRandRange(0.0f, Extent), Stream.FRandRange(0.0f, Extent));
+		const int32 CellX = FMath::Clamp(FMath::FloorToInt(Local.X / CellSize), 0, GridDim - 1);
+		const int32 CellY = FMath::Clamp(FMath::FloorToInt(Local.Y / CellSize), 0, GridDim - 1);
+
+		bool bTooClose = false;
+		for (int32 Y = FMath::Max(CellY - 2, 0); Y <= FMath::Min(CellY + 2, GridDim - 1) && !bTooClose; ++Y)
+		{
+			for (int32 X = FMath::Max(CellX - 2, 0); X <= FMath::Min(CellX + 2, GridDim - 1); ++X)
+			{
+				const int32 Neighbor = Grid[Y * GridDim + X];
+				if (Neighbor != INDEX_NONE && FVector2D::DistSquared(OutPoints[Neighbor] - Origin, Local) < MinSpacingSq)
+				{
+					bTooClose = true;
+					break;
+				}
+			}
+		}
+
+		if (!bTooClose)
+		{
+			Grid[CellY * GridDim + CellX] = OutPoints.Num();
+			OutPoints.Add(Origin + Local);
+		}
+	}
+
+	if (OutPoints.Num() < Count)
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Poisson-disk sampling placed %d of %d points (spacing %.0f, half extent %.0f)."), OutPoints.Num(), Count, MinSpacing, HalfExtent);
+	}
+}
+
+void FOrbitalSectorGenerator::GenerateResourceField(FRandomStream& Stream, const FOrbitalSectorGenerationParams& Params, int32 AsteroidCount, int32 WreckCount, bool bIncludeMissionWreck, TArray<FOrbitalResourceNodeSpawn>& OutNodes)
+{
+	TArray<FVector2D> Points;
+	SamplePoissonDisk(Stream, FVector2D(Params.Center), Params.FieldRadius, Params.MinNodeSpacing, AsteroidCount + WreckCount, Points);
+
+	// Wrecks take the first points so the mission wreck survives a crowded field that could not place every node.
+	const int32 NumWrecks = FMath::Min(WreckCount, Points.Num());
+	const int32 NumAsteroids = FMath::Min(AsteroidCount, Points.Num() - NumWrecks);
+	OutNodes.Reserve(OutNodes.Num() + NumWrecks + NumAsteroids);
+
+	for (int32 i = 0; i < NumWrecks + NumAsteroids; ++i)
+	{
+		const bool bWreck = i < NumWrecks;
+
+		FOrbitalResourceNodeSpawn& Node = OutNodes.AddDefaulted_GetRef();
+		Node.Location = FVector(Points[i], Params.Center.Z);
+
+		if (bWreck)
+		{
+			Node.Kind = EOrbitalResourceNodeKind::Wreck;
+			Node.ResourceType = EOrbitalResourceType::Salvage;
+			Node.Units = Stream.FRandRange(80.0f, 190.0f);
+			Node.Scale = Stream.FRandRange(1.1f, 2.0f);
+			Node.UnitVolume = 1.0f;
+			Node.UnitCreditValue = 24;
+			Node.MiningResistance = 0.9f;
+			Node.bContainsBlackBox = bIncludeMissionWreck && i == 0;
+		}
+		else
+		{
+			Node.Kind = EOrbitalResourceNodeKind::Asteroid;
+			Node.ResourceType = EOrbitalResourceType::Ore;
+			Node.Units = Stream.FRandRange(180.0f, 360.0f);
+			Node.Scale = Stream.FRandRange(1.6f, 3.0f);
+			Node.UnitVolume = 1.5f;
+			Node.UnitCreditValue = 16;
+			Node.MiningResistance = 1.2f;
+		}
+	}
+}
+
+void FOrbitalSectorGenerator::GenerateEnemyDrones(FRandomStream& Stream, const FOrbitalSectorGenerationParams& Params, const FVector& Center, int32 Count, TArray<FVector>& OutLocations)
+{
+	TArray<FVector2D> Points;
+	SamplePoissonDisk(Stream, FVector2D(Center), Params.DroneSpread, Params.MinDroneSpacing, Count, Points);
+
+	OutLocations.Reserve(OutLocations.Num() + Points.Num());
+	for (const FVector2D& Point : Points)
+	{
+		OutLocations.Add(FVector(Point, Center.Z));
+	}
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OrbitalTypes.h"
+
+/** Spawn description for one node of a resource field. */
+struct FOrbitalResourceNodeSpawn
+{
+	EOrbitalResourceNodeKind Kind = EOrbitalResourceNodeKind::Asteroid;
+	EOrbitalResourceType ResourceType = EOrbitalResourceType::Ore;
+	FVector Location = FVector::ZeroVector;
+	float Units = 0.0f;
+	float MiningResistance = 1.0f;
+	float UnitVolume = 1.0f;
+	int32 UnitCreditValue = 1;
+	float Scale = 1.0f;
+	bool bContainsBlackBox = false;
+};
+
+struct FOrbitalStationSpawn
+{
+	FVector Location = FVector::ZeroVector;
+	bool bIsExtractionBeacon = false;
+};
+
+struct FOrbitalJumpGateSpawn
+{
+	FVector Location = FVector::ZeroVector;
+	EOrbitalSectorId TargetSector = EOrbitalSectorId::Belt;
+};
+
+/**
+ * Plain-data description of everything a sector spawns.
+ * Built without touching the world so it can be prepared on a worker thread ahead of a jump.
+ */
+struct FOrbitalSectorSpawnList
+{
+	EOrbitalSectorId SectorId = EOrbitalSectorId::Belt;
+	int32 Seed = 0;
+	TArray<FOrbitalStationSpawn> Stations;
+	TArray<FOrbitalJumpGateSpawn> JumpGates;
+	TArray<FOrbitalResourceNodeSpawn> ResourceNodes;
+	TArray<FVector> DroneLocations;
+};
+
+struct FOrbitalSectorGenerationParams
+{
+	FVector Center = FVector::ZeroVector;
+	float FieldRadius = 9000.0f;
+	float MinNodeSpacing = 900.0f;
+	float DroneSpread = 1500.0f;
+	float MinDroneSpacing = 300.0f;
+};
+
+/**
+ * Deterministic sector layout generator.
+ * Every random draw comes from one FRandomStream seeded from (sector id, seed), so the same inputs always
+ * produce the same spawn list. Touches no UObjects and is safe to run on any thread.
+ */
+struct FOrbitalSectorGenerator
+{
+	static FOrbitalSectorSpawnList Generate(EOrbitalSectorId SectorId, int32 Seed, const FOrbitalSectorGenerationParams& Params);
+
+	/** Mixes the sector id into the layout seed so sectors sharing a seed still get distinct layouts. */
+	static int32 MakeSectorSeed(EOrbitalSectorId SectorId, int32 Seed);
+
+	/**
+	 * Dart-throwing Poisson-disk sampling over a square of half-size HalfExtent.
+	 * Accepted points are at least MinSpacing apart; a background grid keeps each rejection test to a few cells.
+	 * May return fewer than Count points if the square cannot fit them.
+	 */
+	static void SamplePoissonDisk(FRandomStream& Stream, const FVector2D& Center, float HalfExtent, float MinSpacing, int32 Count, TArray<FVector2D>& OutPoints);
+
+private:
+	static void GenerateResourceField(FRandomStream& Stream, const FOrbitalSectorGenerationParams& Params, int32 AsteroidCount, int32 WreckCount, bool bIncludeMissionWreck, TArray<FOrbitalResourceNodeSpawn>& OutNodes);
+	static void GenerateEnemyDrones(FRandomStream& Stream, const FOrbitalSectorGenerationParams& Params, const FVector& Center, int32 Count, TArray<FVector>& OutLocations);
+};
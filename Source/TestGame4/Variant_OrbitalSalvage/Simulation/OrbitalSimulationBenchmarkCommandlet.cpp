@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalSimulationBenchmarkCommandlet.h"
+#include "OrbitalSimulationSession.h"
+#include "TestGame4.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+UOrbitalSimulationBenchmarkCommandlet::UOrbitalSimulationBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UOrbitalSimulationBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumSessions = 10000;
+	int32 BaseSeed = 1;
+	FOrbitalSessionParams SessionParams;
+
+	FParse::Value(*Params, TEXT("Sessions="), NumSessions);
+	FParse::Value(*Params, TEXT("Seed="), BaseSeed);
+	FParse::Value(*Params, TEXT("MissionCreditGoal="), SessionParams.MissionCreditGoal);
+
+	if (NumSessions <= 0)
+	{
+		UE_LOG(LogTestGame4, Error, TEXT("OrbitalSimulationBenchmark: -Sessions must be positive."));
+		return 1;
+	}
+
+	int64 TotalCredits = 0;
+	int64 TotalSteps = 0;
+	double TotalSessionSeconds = 0.0;
+	int32 NumCompleted = 0;
+	int32 NumDestroyed = 0;
+	int32 NumStranded = 0;
+	uint32 Checksum = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 SessionIndex = 0; SessionIndex < NumSessions; ++SessionIndex)
+	{
+		SessionParams.Seed = BaseSeed + SessionIndex;
+
+		FOrbitalSessionSimulator Simulator(SessionParams);
+		const FOrbitalSessionResult Result = Simulator.Run();
+
+		TotalCredits += Result.Credits;
+		TotalSteps += Result.Steps;
+		TotalSessionSeconds += Result.SessionSeconds;
+		NumCompleted += Result.bMissionComplete ? 1 : 0;
+		NumDestroyed += Result.bShipDestroyed ? 1 : 0;
+		NumStranded += Result.bStranded ? 1 : 0;
+		Checksum = HashCombine(Checksum, HashCombine(GetTypeHash(Result.Credits), GetTypeHash(Result.Steps)));
+	}
+
+	const double WallSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+
+	UE_LOG(LogTestGame4, Display, TEXT("OrbitalSimulationBenchmark: %d sessions in %.3f s (%.0f sessions/s, %.1f M steps/s)"),
+		NumSessions, WallSeconds, NumSessions / WallSeconds, TotalSteps / WallSeconds / 1.0e6);
+	UE_LOG(LogTestGame4, Display, TEXT("  completed %.1f%%, destroyed %.1f%%, stranded %.1f%%"),
+		100.0 * NumCompleted / NumSessions, 100.0 * NumDestroyed / NumSessions, 100.0 * NumStranded / NumSessions);
+	UE_LOG(LogTestGame4, Display, TEXT("  mean credits %.0f, mean session length %.0f s"),
+		static_cast<double>(TotalCredits) / NumSessions, TotalSessionSeconds / NumSessions);
+	UE_LOG(LogTestGame4, Display, TEXT("  checksum %08x (seeds %d..%d)"), Checksum, BaseSeed, BaseSeed + NumSessions - 1);
+
+	return 0;
+}
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OrbitalSimulationBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs many headless Orbital Salvage sessions on one thread and reports throughput and economy totals.
+ * Same seeds always give the same checksum, so the output doubles as a regression baseline.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=OrbitalSimulationBenchmark [-Sessions=10000] [-Seed=1] [-MissionCreditGoal=0]
+ */
+UCLASS()
+class UOrbitalSimulationBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOrbitalSimulationBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
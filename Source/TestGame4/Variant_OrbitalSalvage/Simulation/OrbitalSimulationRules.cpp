@@ -0,0 +1,268 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalSimulationRules.h"
+
+float FOrbitalShipVitals::EvaluateHull(float ElapsedSeconds) const
+{
+	return FMath::Max(0.0f, Hull - OverheatHullDamagePerSecond * GetOverheatSeconds(ElapsedSeconds));
+}
+
+float FOrbitalShipVitals::EvaluatePower(float ElapsedSeconds) const
+{
+	const float NetRate = PowerRegenPerSecond - PowerDrainPerSecond;
+	return FMath::Clamp(Power + NetRate * ElapsedSeconds, 0.0f, MaxPower);
+}
+
+float FOrbitalShipVitals::EvaluateHeat(float ElapsedSeconds) const
+{
+	return FMath::Clamp(Heat - HeatDissipationPerSecond * ElapsedSeconds, 0.0f, MaxHeat * 2.0f);
+}
+
+float FOrbitalShipVitals::GetOverheatSeconds(float ElapsedSeconds) const
+{
+	if (Heat <= MaxHeat || ElapsedSeconds <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	if (HeatDissipationPerSecond <= 0.0f)
+	{
+		return ElapsedSeconds;
+	}
+
+	return FMath::Min(ElapsedSeconds, (Heat - MaxHeat) / HeatDissipationPerSecond);
+}
+
+void FOrbitalShipVitals::Advance(float ElapsedSeconds)
+{
+	if (ElapsedSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	// Hull first: the overheat window depends on the heat value before this step.
+	Hull = EvaluateHull(ElapsedSeconds);
+	Power = EvaluatePower(ElapsedSeconds);
+	Heat = EvaluateHeat(ElapsedSeconds);
+}
+
+float FOrbitalShipVitals::GetSecondsToNextThreshold() const
+{
+	// Crossings already within tolerance are ignored so a settle landing exactly on a limit does not re-fire.
+	float Delay = TNumericLimits<float>::Max();
+	auto ConsiderCrossing = [&Delay](float Distance, float Rate)
+	{
+		if (Distance > KINDA_SMALL_NUMBER && Rate > KINDA_SMALL_NUMBER)
+		{
+			Delay = FMath::Min(Delay, Distance / Rate);
+		}
+	};
+
+	const float NetPowerRate = PowerRegenPerSecond - PowerDrainPerSecond;
+	ConsiderCrossing(MaxPower - Power, NetPowerRate);
+	ConsiderCrossing(Power, -NetPowerRate);
+	ConsiderCrossing(Heat - MaxHeat, HeatDissipationPerSecond);
+	ConsiderCrossing(Heat, HeatDissipationPerSecond);
+
+	if (Heat > MaxHeat)
+	{
+		ConsiderCrossing(Hull, OverheatHullDamagePerSecond);
+	}
+
+	return Delay < TNumericLimits<float>::Max() ? Delay : -1.0f;
+}
+
+uint8 FOrbitalShipVitals::GetThresholdFlags() const
+{
+	uint8 Flags = 0;
+	Flags |= Power >= MaxPower ? PowerFull : 0;
+	Flags |= Power <= 0.0f ? PowerDepleted : 0;
+	Flags |= Heat > MaxHeat ? Overheated : 0;
+	Flags |= Heat <= 0.0f ? HeatCleared : 0;
+	Flags |= Hull <= 0.0f ? HullDestroyed : 0;
+	return Flags;
+}
+
+void FOrbitalCargoLedger::Reset()
+{
+	for (int32 TypeIndex = 0; TypeIndex < NumResourceTypes; ++TypeIndex)
+	{
+		Units[TypeIndex] = 0.0f;
+		UnitPrices[TypeIndex] = 0;
+	}
+
+	Used = 0.0f;
+}
+
+float FOrbitalCargoLedger::Add(EOrbitalResourceType ResourceType, float InUnits, float UnitVolume, int32 UnitCreditValue, float Capacity)
+{
+	if (InUnits <= 0.0f || UnitVolume <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float FreeVolume = FMath::Max(0.0f, Capacity - Used);
+	const float MaxUnitsByVolume = FreeVolume / UnitVolume;
+	const float AddedUnits = FMath::Clamp(InUnits, 0.0f, MaxUnitsByVolume);
+
+	if (AddedUnits <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	Used += AddedUnits * UnitVolume;
+	Used = FMath::Min(Used, Capacity);
+
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+	Units[TypeIndex] += AddedUnits;
+	UnitPrices[TypeIndex] = UnitCreditValue;
+	return AddedUnits;
+}
+
+float FOrbitalCargoLedger::Remove(EOrbitalResourceType ResourceType, float InUnits)
+{
+	float& CurrentUnits = Units[static_cast<int32>(ResourceType)];
+	if (CurrentUnits <= 0.0f || InUnits <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float RemovedUnits = FMath::Min(CurrentUnits, InUnits);
+	CurrentUnits -= RemovedUnits;
+	if (CurrentUnits <= KINDA_SMALL_NUMBER)
+	{
+		CurrentUnits = 0.0f;
+	}
+
+	Used = FMath::Max(0.0f, Used - RemovedUnits * GetUnitVolume(ResourceType));
+	return RemovedUnits;
+}
+
+int32 FOrbitalCargoLedger::SellAll()
+{
+	int32 TotalRevenue = 0;
+
+	for (int32 TypeIndex = 0; TypeIndex < NumResourceTypes; ++TypeIndex)
+	{
+		const int32 UnitsRounded = FMath::FloorToInt(Units[TypeIndex]);
+		TotalRevenue += UnitsRounded * UnitPrices[TypeIndex];
+		Units[TypeIndex] = 0.0f;
+	}
+
+	Used = 0.0f;
+	return TotalRevenue;
+}
+
+float FOrbitalCargoLedger::GetUnitVolume(EOrbitalResourceType ResourceType)
+{
+	switch (ResourceType)
+	{
+	case EOrbitalResourceType::Ore:
+		return 1.5f;
+	case EOrbitalResourceType::Salvage:
+		return 1.0f;
+	case EOrbitalResourceType::FuelCell:
+		return 2.0f;
+	case EOrbitalResourceType::BlackBox:
+		return 8.0f;
+	default:
+		return 1.0f;
+	}
+}
+
+int32 FOrbitalUpgradeRules::GetCost(EOrbitalUpgradeType UpgradeType, int32 CurrentLevel)
+{
+	const int32 BaseCost = [&]()
+	{
+		switch (UpgradeType)
+		{
+		case EOrbitalUpgradeType::Reactor:
+			return 1300;
+		case EOrbitalUpgradeType::CargoPod:
+			return 1000;
+		case EOrbitalUpgradeType::MiningLaser:
+			return 1200;
+		default:
+			return 1200;
+		}
+	}();
+
+	return BaseCost + (CurrentLevel * 800);
+}
+
+float FOrbitalUpgradeRules::GetMiningYieldMultiplier(int32 LaserLevel)
+{
+	return 1.0f + (LaserLevel * 0.35f);
+}
+
+float FOrbitalUpgradeRules::GetMiningHeatMultiplier(int32 ReactorLevel)
+{
+	return FMath::Max(0.45f, 1.0f - (ReactorLevel * 0.12f));
+}
+
+void FOrbitalUpgradeRules::ApplyUpgrade(EOrbitalUpgradeType UpgradeType, FOrbitalShipVitals& Vitals, float& CargoCapacity)
+{
+	switch (UpgradeType)
+	{
+	case EOrbitalUpgradeType::Reactor:
+		Vitals.MaxPower += 20.0f;
+		Vitals.PowerRegenPerSecond += 4.0f;
+		Vitals.Power = Vitals.MaxPower;
+		break;
+	case EOrbitalUpgradeType::CargoPod:
+		CargoCapacity += 70.0f;
+		break;
+	case EOrbitalUpgradeType::MiningLaser:
+		Vitals.MaxHeat += 12.0f;
+		break;
+	default:
+		break;
+	}
+}
+
+float FOrbitalMiningRules::Extract(float RequestedUnits, float MiningResistance, float& UnitsRemaining)
+{
+	if (RequestedUnits <= 0.0f || UnitsRemaining <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float EffectiveRequest = RequestedUnits / FMath::Max(MiningResistance, 0.25f);
+	const float Extracted = FMath::Min(EffectiveRequest, UnitsRemaining);
+
+	UnitsRemaining -= Extracted;
+	return Extracted;
+}
+
+FOrbitalDockingQuote FOrbitalDockingRules::QuoteService(float HullMissing, float FuelMissing)
+{
+	FOrbitalDockingQuote Quote;
+	Quote.RepairCost = FMath::CeilToInt(HullMissing * 3.0f);
+	Quote.FuelCost = FMath::CeilToInt(FuelMissing * 2.0f);
+	return Quote;
+}
+
+EOrbitalMissionStage FOrbitalMissionRules::OnBlackBoxRecovered(EOrbitalMissionStage Stage)
+{
+	return Stage == EOrbitalMissionStage::RetrieveBlackBox ? EOrbitalMissionStage::JumpToRuins : Stage;
+}
+
+EOrbitalMissionStage FOrbitalMissionRules::OnEnteredSector(EOrbitalMissionStage Stage, EOrbitalSectorId Sector)
+{
+	if (Stage == EOrbitalMissionStage::JumpToRuins && Sector == EOrbitalSectorId::Ruins)
+	{
+		return EOrbitalMissionStage::ExtractAtBeacon;
+	}
+
+	return Stage;
+}
+
+bool FOrbitalMissionRules::CanCompleteExtraction(EOrbitalMissionStage Stage, bool bHasRecoveredBlackBox)
+{
+	return Stage == EOrbitalMissionStage::ExtractAtBeacon && bHasRecoveredBlackBox;
+}
+
+bool FOrbitalMissionRules::IsJumpLocked(EOrbitalMissionStage Stage, EOrbitalSectorId TargetSector)
+{
+	return Stage == EOrbitalMissionStage::RetrieveBlackBox && TargetSector == EOrbitalSectorId::Ruins;
+}
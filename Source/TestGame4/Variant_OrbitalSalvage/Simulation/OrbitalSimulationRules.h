@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "OrbitalTypes.h"
+
+/**
+ * Power, heat and hull of one ship at a settle point, plus the rates that move them between settles.
+ * Every value is closed form in the elapsed time, so a ship only needs attention when a threshold is crossed.
+ */
+struct FOrbitalShipVitals
+{
+	enum EThresholdFlags : uint8
+	{
+		PowerFull		= 1 << 0,
+		PowerDepleted	= 1 << 1,
+		Overheated		= 1 << 2,
+		HeatCleared		= 1 << 3,
+		HullDestroyed	= 1 << 4
+	};
+
+	float Hull = 100.0f;
+	float Power = 120.0f;
+	float MaxPower = 120.0f;
+	float PowerRegenPerSecond = 25.0f;
+	float PowerDrainPerSecond = 1.0f;
+	float Heat = 0.0f;
+	float MaxHeat = 100.0f;
+	float HeatDissipationPerSecond = 16.0f;
+	float OverheatHullDamagePerSecond = 5.0f;
+
+	float EvaluateHull(float ElapsedSeconds) const;
+	float EvaluatePower(float ElapsedSeconds) const;
+	float EvaluateHeat(float ElapsedSeconds) const;
+
+	/** Seconds of the elapsed window the ship spends above MaxHeat. */
+	float GetOverheatSeconds(float ElapsedSeconds) const;
+
+	void Advance(float ElapsedSeconds);
+
+	/** Seconds until the first value reaches a limit at the current rates, or a negative value if none is moving toward one. */
+	float GetSecondsToNextThreshold() const;
+
+	uint8 GetThresholdFlags() const;
+};
+
+/** Per-resource cargo hold. Fixed size and indexed by EOrbitalResourceType, so filling it never hashes or allocates. */
+struct FOrbitalCargoLedger
+{
+	static constexpr int32 NumResourceTypes = static_cast<int32>(EOrbitalResourceType::BlackBox) + 1;
+
+	TStaticArray<float, NumResourceTypes> Units;
+	TStaticArray<int32, NumResourceTypes> UnitPrices;
+	float Used = 0.0f;
+
+	FOrbitalCargoLedger() { Reset(); }
+
+	void Reset();
+
+	/** Adds as many units as fit in Capacity and returns the amount added. */
+	float Add(EOrbitalResourceType ResourceType, float InUnits, float UnitVolume, int32 UnitCreditValue, float Capacity);
+	float Remove(EOrbitalResourceType ResourceType, float InUnits);
+	float GetUnits(EOrbitalResourceType ResourceType) const { return Units[static_cast<int32>(ResourceType)]; }
+
+	/** Empties the hold and returns the revenue for whole units. */
+	int32 SellAll();
+
+	static float GetUnitVolume(EOrbitalResourceType ResourceType);
+};
+
+struct FOrbitalUpgradeRules
+{
+	static constexpr int32 NumUpgradeTypes = static_cast<int32>(EOrbitalUpgradeType::MiningLaser) + 1;
+	static constexpr int32 MaxLevel = 3;
+
+	static int32 GetCost(EOrbitalUpgradeType UpgradeType, int32 CurrentLevel);
+	static float GetMiningYieldMultiplier(int32 LaserLevel);
+	static float GetMiningHeatMultiplier(int32 ReactorLevel);
+
+	/** Applies the stat changes of one purchased level. */
+	static void ApplyUpgrade(EOrbitalUpgradeType UpgradeType, FOrbitalShipVitals& Vitals, float& CargoCapacity);
+};
+
+struct FOrbitalMiningRules
+{
+	/** Takes up to RequestedUnits, scaled down by resistance, out of UnitsRemaining and returns the amount taken. */
+	static float Extract(float RequestedUnits, float MiningResistance, float& UnitsRemaining);
+
+	static bool IsDepleted(float UnitsRemaining) { return UnitsRemaining <= KINDA_SMALL_NUMBER; }
+};
+
+struct FOrbitalCombatRules
+{
+	static constexpr float DroneAttackInterval = 0.2f;
+
+	/** Advances a drone's attack timer and returns the hull damage it deals this step. */
+	static FORCEINLINE float AccumulateDroneAttack(float& Accumulator, float DeltaSeconds, float HullDamagePerSecond)
+	{
+		Accumulator += DeltaSeconds;
+		if (Accumulator < DroneAttackInterval)
+		{
+			return 0.0f;
+		}
+
+		Accumulator = 0.0f;
+		return HullDamagePerSecond * DroneAttackInterval;
+	}
+
+	/** Applies beam damage and returns true if the drone was destroyed by it. */
+	static FORCEINLINE bool ApplyDroneDamage(float& Health, float DamageAmount)
+	{
+		Health -= DamageAmount;
+		return Health <= 0.0f;
+	}
+};
+
+/** Auto-service bill presented when a ship docks. */
+struct FOrbitalDockingQuote
+{
+	int32 RepairCost = 0;
+	int32 FuelCost = 0;
+
+	int32 GetTotal() const { return RepairCost + FuelCost; }
+};
+
+struct FOrbitalDockingRules
+{
+	static FOrbitalDockingQuote QuoteService(float HullMissing, float FuelMissing);
+};
+
+/** Stage transitions of the black box mission. */
+struct FOrbitalMissionRules
+{
+	static EOrbitalMissionStage OnBlackBoxRecovered(EOrbitalMissionStage Stage);
+	static EOrbitalMissionStage OnEnteredSector(EOrbitalMissionStage Stage, EOrbitalSectorId Sector);
+	static bool CanCompleteExtraction(EOrbitalMissionStage Stage, bool bHasRecoveredBlackBox);
+	static bool IsJumpLocked(EOrbitalMissionStage Stage, EOrbitalSectorId TargetSector);
+};
@@ -0,0 +1,403 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OrbitalSimulationSession.h"
+
+FOrbitalSessionSimulator::FOrbitalSessionSimulator(const FOrbitalSessionParams& InParams)
+	: Params(InParams)
+{
+	for (int32& Level : UpgradeLevels)
+	{
+		Level = 0;
+	}
+}
+
+FOrbitalSessionResult FOrbitalSessionSimulator::Run()
+{
+	Result = FOrbitalSessionResult();
+
+	Vitals = FOrbitalShipVitals();
+	Vitals.Hull = Params.MaxHull;
+	Fuel = Params.MaxFuel;
+	CargoCapacity = Params.CargoCapacity;
+	Credits = Params.StartingCredits;
+	Cargo.Reset();
+
+	for (int32& Level : UpgradeLevels)
+	{
+		Level = 0;
+	}
+
+	Stage = EOrbitalMissionStage::RetrieveBlackBox;
+	bHasRecoveredBlackBox = false;
+	EnterSector(EOrbitalSectorId::Belt);
+
+	const float DeltaSeconds = FMath::Max(Params.StepSeconds, KINDA_SMALL_NUMBER);
+	while (Result.SessionSeconds < Params.MaxSessionSeconds)
+	{
+		Step(DeltaSeconds);
+		++Result.Steps;
+		Result.SessionSeconds += DeltaSeconds;
+
+		if (Result.bShipDestroyed || Result.bStranded || Result.bFieldExhausted || (Result.bMissionComplete && Params.bStopOnMissionComplete))
+		{
+			break;
+		}
+	}
+
+	Result.Credits = Credits;
+	return Result;
+}
+
+void FOrbitalSessionSimulator::EnterSector(EOrbitalSectorId NewSector)
+{
+	Sector = NewSector;
+
+	const FOrbitalSectorSpawnList Layout = FOrbitalSectorGenerator::Generate(NewSector, Params.Seed, Params.Generation);
+	const FVector2D Center(Params.Generation.Center);
+
+	StationLocation = Layout.Stations.Num() > 0 ? FVector2D(Layout.Stations[0].Location) : Center;
+	bStationIsBeacon = Layout.Stations.Num() > 0 && Layout.Stations[0].bIsExtractionBeacon;
+	GateLocation = Layout.JumpGates.Num() > 0 ? FVector2D(Layout.JumpGates[0].Location) : Center;
+	GateTarget = Layout.JumpGates.Num() > 0 ? Layout.JumpGates[0].TargetSector : NewSector;
+
+	Nodes.Reset(Layout.ResourceNodes.Num());
+	for (const FOrbitalResourceNodeSpawn& Spawn : Layout.ResourceNodes)
+	{
+		FNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Location = FVector2D(Spawn.Location);
+		Node.UnitsRemaining = Spawn.Units;
+		Node.MiningResistance = Spawn.MiningResistance;
+		Node.UnitVolume = Spawn.UnitVolume;
+		Node.UnitCreditValue = Spawn.UnitCreditValue;
+		Node.ResourceType = Spawn.ResourceType;
+		Node.bWreck = Spawn.Kind == EOrbitalResourceNodeKind::Wreck;
+		Node.bContainsBlackBox = Spawn.bContainsBlackBox;
+	}
+
+	Drones.Reset(Layout.DroneLocations.Num());
+	for (const FVector& Location : Layout.DroneLocations)
+	{
+		FDrone& Drone = Drones.AddDefaulted_GetRef();
+		Drone.Location = FVector2D(Location);
+		Drone.Health = Params.DroneMaxHealth;
+	}
+
+	TargetNode = INDEX_NONE;
+	ShipLocation = Center + Params.SpawnOffset;
+}
+
+void FOrbitalSessionSimulator::Step(float DeltaSeconds)
+{
+	Vitals.Advance(DeltaSeconds);
+	SimulateDrones(DeltaSeconds);
+
+	if (Vitals.Hull <= 0.0f)
+	{
+		Result.bShipDestroyed = true;
+		return;
+	}
+
+	switch (ChooseGoal())
+	{
+	case EPilotGoal::Mine:
+		if (!FireBeamAtDrones(DeltaSeconds))
+		{
+			MineTarget(DeltaSeconds);
+		}
+		break;
+	case EPilotGoal::Dock:
+		if (MoveTowards(StationLocation, Params.DockRange, DeltaSeconds))
+		{
+			Dock();
+			Result.bFieldExhausted = Nodes.Num() == 0 && ChooseGoal() == EPilotGoal::Dock;
+		}
+		break;
+	case EPilotGoal::Jump:
+		if (MoveTowards(GateLocation, Params.GateRange, DeltaSeconds))
+		{
+			Jump();
+		}
+		break;
+	}
+
+	if (Fuel <= KINDA_SMALL_NUMBER && FVector2D::DistSquared(ShipLocation, StationLocation) > FMath::Square(Params.DockRange))
+	{
+		Result.bStranded = true;
+	}
+}
+
+FOrbitalSessionSimulator::EPilotGoal FOrbitalSessionSimulator::ChooseGoal() const
+{
+	if (Credits >= Params.MissionCreditGoal)
+	{
+		if (Stage == EOrbitalMissionStage::ExtractAtBeacon)
+		{
+			return EPilotGoal::Dock;
+		}
+
+		if (Stage == EOrbitalMissionStage::JumpToRuins && Sector != EOrbitalSectorId::Ruins)
+		{
+			return EPilotGoal::Jump;
+		}
+	}
+
+	const bool bNeedsService = Cargo.Used >= CargoCapacity * 0.9f
+		|| Vitals.Hull < Params.MaxHull * 0.35f
+		|| Fuel < Params.MaxFuel * 0.25f;
+
+	if (bNeedsService || Nodes.Num() == 0)
+	{
+		return EPilotGoal::Dock;
+	}
+
+	return EPilotGoal::Mine;
+}
+
+bool FOrbitalSessionSimulator::MoveTowards(const FVector2D& Destination, float StopDistance, float DeltaSeconds)
+{
+	const FVector2D Delta = Destination - ShipLocation;
+	const float Distance = Delta.Size();
+	if (Distance <= StopDistance)
+	{
+		return true;
+	}
+
+	// Thrusting costs both, and like the pawn a missing resource still burns the other.
+	const bool bHasFuel = TryConsumeFuel(Params.CruiseFuelPerSecond * DeltaSeconds);
+	const bool bHasPower = TryConsumePower(Params.CruisePowerPerSecond * DeltaSeconds);
+	if (!bHasFuel || !bHasPower)
+	{
+		return false;
+	}
+
+	const float Move = FMath::Min(Params.CruiseSpeed * DeltaSeconds, Distance);
+	ShipLocation += Delta * (Move / Distance);
+	return Distance - Move <= StopDistance;
+}
+
+void FOrbitalSessionSimulator::MineTarget(float DeltaSeconds)
+{
+	if (!Nodes.IsValidIndex(TargetNode))
+	{
+		TargetNode = FindMiningTarget();
+		if (TargetNode == INDEX_NONE)
+		{
+			return;
+		}
+	}
+
+	FNode& Node = Nodes[TargetNode];
+	if (!MoveTowards(Node.Location, Params.MiningRange * 0.5f, DeltaSeconds) || !FireBeam(DeltaSeconds))
+	{
+		return;
+	}
+
+	const float Requested = Params.MiningRatePerSecond * FOrbitalUpgradeRules::GetMiningYieldMultiplier(GetUpgradeLevel(EOrbitalUpgradeType::MiningLaser)) * DeltaSeconds;
+	const float Extracted = FOrbitalMiningRules::Extract(Requested, Node.MiningResistance, Node.UnitsRemaining);
+	if (Extracted > 0.0f)
+	{
+		Result.UnitsMined += Cargo.Add(Node.ResourceType, Extracted, Node.UnitVolume, Node.UnitCreditValue, CargoCapacity);
+	}
+
+	if (Node.bContainsBlackBox && Node.bWreck)
+	{
+		Node.bContainsBlackBox = false;
+		Cargo.Add(EOrbitalResourceType::BlackBox, 1.0f, 8.0f, 0, CargoCapacity);
+
+		if (!bHasRecoveredBlackBox)
+		{
+			bHasRecoveredBlackBox = true;
+			Stage = FOrbitalMissionRules::OnBlackBoxRecovered(Stage);
+		}
+	}
+
+	if (FOrbitalMiningRules::IsDepleted(Node.UnitsRemaining))
+	{
+		Nodes.RemoveAtSwap(TargetNode, 1, EAllowShrinking::No);
+		TargetNode = INDEX_NONE;
+	}
+}
+
+bool FOrbitalSessionSimulator::FireBeamAtDrones(float DeltaSeconds)
+{
+	int32 NearestDrone = INDEX_NONE;
+	float NearestDistSq = FMath::Square(Params.MiningRange);
+	for (int32 i = 0; i < Drones.Num(); ++i)
+	{
+		const float DistSq = FVector2D::DistSquared(ShipLocation, Drones[i].Location);
+		if (DistSq <= NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			NearestDrone = i;
+		}
+	}
+
+	if (NearestDrone == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (FireBeam(DeltaSeconds) && FOrbitalCombatRules::ApplyDroneDamage(Drones[NearestDrone].Health, Params.MiningDamagePerSecond * DeltaSeconds))
+	{
+		Credits += Params.DroneBounty;
+		++Result.DronesDestroyed;
+		Drones.RemoveAtSwap(NearestDrone, 1, EAllowShrinking::No);
+	}
+
+	return true;
+}
+
+bool FOrbitalSessionSimulator::FireBeam(float DeltaSeconds)
+{
+	// Let the emitter cool rather than run it into overheat damage.
+	if (Vitals.Heat > Vitals.MaxHeat * 0.9f)
+	{
+		return false;
+	}
+
+	if (!TryConsumePower(Params.MiningPowerPerSecond * DeltaSeconds) || !TryConsumeFuel(Params.MiningFuelPerSecond * DeltaSeconds))
+	{
+		return false;
+	}
+
+	const float HeatMultiplier = FOrbitalUpgradeRules::GetMiningHeatMultiplier(GetUpgradeLevel(EOrbitalUpgradeType::Reactor));
+	Vitals.Heat = FMath::Clamp(Vitals.Heat + Params.MiningHeatPerSecond * HeatMultiplier * DeltaSeconds, 0.0f, Vitals.MaxHeat * 2.0f);
+	return true;
+}
+
+void FOrbitalSessionSimulator::Dock()
+{
+	++Result.DockVisits;
+	Credits += Cargo.SellAll();
+
+	const float HullMissing = Params.MaxHull - Vitals.Hull;
+	const float FuelMissing = Params.MaxFuel - Fuel;
+	const int32 ServiceCost = FOrbitalDockingRules::QuoteService(HullMissing, FuelMissing).GetTotal();
+	if (Credits >= ServiceCost)
+	{
+		Credits -= ServiceCost;
+		Vitals.Hull = Params.MaxHull;
+		Fuel = Params.MaxFuel;
+	}
+
+	if (bStationIsBeacon && FOrbitalMissionRules::CanCompleteExtraction(Stage, bHasRecoveredBlackBox))
+	{
+		Stage = EOrbitalMissionStage::Completed;
+		Credits += Params.MissionReward;
+		Result.bMissionComplete = true;
+	}
+
+	BuyUpgrades();
+}
+
+void FOrbitalSessionSimulator::BuyUpgrades()
+{
+	for (;;)
+	{
+		int32 CheapestType = INDEX_NONE;
+		int32 CheapestCost = TNumericLimits<int32>::Max();
+		for (int32 TypeIndex = 0; TypeIndex < FOrbitalUpgradeRules::NumUpgradeTypes; ++TypeIndex)
+		{
+			const int32 Level = UpgradeLevels[TypeIndex];
+			const int32 Cost = FOrbitalUpgradeRules::GetCost(static_cast<EOrbitalUpgradeType>(TypeIndex), Level);
+			if (Level < FOrbitalUpgradeRules::MaxLevel && Cost < CheapestCost)
+			{
+				CheapestType = TypeIndex;
+				CheapestCost = Cost;
+			}
+		}
+
+		if (CheapestType == INDEX_NONE || Credits - CheapestCost < Params.UpgradeCreditReserve)
+		{
+			return;
+		}
+
+		Credits -= CheapestCost;
+		++UpgradeLevels[CheapestType];
+		FOrbitalUpgradeRules::ApplyUpgrade(static_cast<EOrbitalUpgradeType>(CheapestType), Vitals, CargoCapacity);
+		++Result.UpgradesPurchased;
+	}
+}
+
+void FOrbitalSessionSimulator::Jump()
+{
+	if (FOrbitalMissionRules::IsJumpLocked(Stage, GateTarget))
+	{
+		return;
+	}
+
+	EnterSector(GateTarget);
+	Stage = FOrbitalMissionRules::OnEnteredSector(Stage, Sector);
+}
+
+void FOrbitalSessionSimulator::SimulateDrones(float DeltaSeconds)
+{
+	const float ChaseRangeSq = FMath::Square(Params.DroneChaseRange);
+	const float AttackRangeSq = FMath::Square(Params.DroneAttackRange);
+	const float Step = Params.DroneMoveSpeed * DeltaSeconds;
+
+	for (FDrone& Drone : Drones)
+	{
+		const FVector2D Delta = ShipLocation - Drone.Location;
+		const float DistSq = Delta.SizeSquared();
+		if (DistSq > ChaseRangeSq || DistSq <= UE_KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		Drone.Location += Delta * (FMath::InvSqrt(DistSq) * Step);
+
+		if (DistSq <= AttackRangeSq)
+		{
+			const float HullDamage = FOrbitalCombatRules::AccumulateDroneAttack(Drone.AttackAccumulator, DeltaSeconds, Params.DroneHullDamagePerSecond);
+			Vitals.Hull = FMath::Max(0.0f, Vitals.Hull - HullDamage);
+		}
+	}
+}
+
+int32 FOrbitalSessionSimulator::FindMiningTarget() const
+{
+	// While the black box is still out there the pilot works wrecks first.
+	const bool bPreferWrecks = Stage == EOrbitalMissionStage::RetrieveBlackBox;
+
+	int32 BestNode = INDEX_NONE;
+	float BestScore = TNumericLimits<float>::Max();
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		float Score = FVector2D::DistSquared(ShipLocation, Nodes[i].Location);
+		if (bPreferWrecks && !Nodes[i].bWreck)
+		{
+			Score *= 4.0f;
+		}
+
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			BestNode = i;
+		}
+	}
+
+	return BestNode;
+}
+
+bool FOrbitalSessionSimulator::TryConsumePower(float Amount)
+{
+	if (Vitals.Power < Amount)
+	{
+		return false;
+	}
+
+	Vitals.Power -= Amount;
+	return true;
+}
+
+bool FOrbitalSessionSimulator::TryConsumeFuel(float Amount)
+{
+	if (Fuel < Amount)
+	{
+		return false;
+	}
+
+	Fuel -= Amount;
+	return true;
+}
@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OrbitalSimulationRules.h"
+#include "OrbitalSectorGenerator.h"
+
+/** Tuning for one headless session. Defaults mirror the gameplay actor and component defaults. */
+struct FOrbitalSessionParams
+{
+	int32 Seed = 0;
+	float StepSeconds = 0.25f;
+	float MaxSessionSeconds = 1800.0f;
+
+	// Ship
+	float MaxHull = 100.0f;
+	float MaxFuel = 350.0f;
+	float CargoCapacity = 220.0f;
+	int32 StartingCredits = 2500;
+	float CruiseSpeed = 2500.0f;
+	float CruiseFuelPerSecond = 3.0f;
+	float CruisePowerPerSecond = 10.0f;
+	FVector2D SpawnOffset = FVector2D(-2500.0f, -1000.0f);
+
+	// Mining beam
+	float MiningRange = 3500.0f;
+	float MiningRatePerSecond = 28.0f;
+	float MiningPowerPerSecond = 16.0f;
+	float MiningHeatPerSecond = 13.0f;
+	float MiningFuelPerSecond = 2.0f;
+	float MiningDamagePerSecond = 20.0f;
+
+	// Drones
+	float DroneMaxHealth = 90.0f;
+	float DroneMoveSpeed = 900.0f;
+	float DroneChaseRange = 5500.0f;
+	float DroneAttackRange = 550.0f;
+	float DroneHullDamagePerSecond = 8.0f;
+	int32 DroneBounty = 120;
+
+	// Stations and mission
+	float DockRange = 900.0f;
+	float GateRange = 700.0f;
+	int32 MissionReward = 4000;
+
+	// Pilot
+	/** The pilot only heads for the mission once it has banked this many credits. */
+	int32 MissionCreditGoal = 0;
+	/** Credits the pilot keeps in hand for repairs when buying upgrades. */
+	int32 UpgradeCreditReserve = 1500;
+	bool bStopOnMissionComplete = true;
+
+	FOrbitalSectorGenerationParams Generation;
+};
+
+struct FOrbitalSessionResult
+{
+	int32 Credits = 0;
+	float SessionSeconds = 0.0f;
+	int32 Steps = 0;
+	float UnitsMined = 0.0f;
+	int32 DronesDestroyed = 0;
+	int32 DockVisits = 0;
+	int32 UpgradesPurchased = 0;
+	bool bMissionComplete = false;
+	bool bShipDestroyed = false;
+	bool bStranded = false;
+
+	/** Nothing left to mine and nowhere left to go. */
+	bool bFieldExhausted = false;
+};
+
+/**
+ * Plays one full Orbital Salvage session without a world: the ship is flown by a scripted pilot that mines,
+ * fights drones, docks to sell and upgrade, and runs the black box mission, using the same rules as the
+ * gameplay components. Deterministic for a given seed; used for offline economy balancing and benchmarks.
+ */
+class FOrbitalSessionSimulator
+{
+public:
+	explicit FOrbitalSessionSimulator(const FOrbitalSessionParams& InParams);
+
+	FOrbitalSessionResult Run();
+
+private:
+	enum class EPilotGoal : uint8
+	{
+		Mine,
+		Dock,
+		Jump
+	};
+
+	struct FNode
+	{
+		FVector2D Location = FVector2D::ZeroVector;
+		float UnitsRemaining = 0.0f;
+		float MiningResistance = 1.0f;
+		float UnitVolume = 1.0f;
+		int32 UnitCreditValue = 1;
+		EOrbitalResourceType ResourceType = EOrbitalResourceType::Ore;
+		bool bWreck = false;
+		bool bContainsBlackBox = false;
+	};
+
+	struct FDrone
+	{
+		FVector2D Location = FVector2D::ZeroVector;
+		float Health = 0.0f;
+		float AttackAccumulator = 0.0f;
+	};
+
+	FOrbitalSessionParams Params;
+	FOrbitalSessionResult Result;
+
+	// Ship
+	FVector2D ShipLocation = FVector2D::ZeroVector;
+	FOrbitalShipVitals Vitals;
+	float Fuel = 0.0f;
+	float CargoCapacity = 0.0f;
+	int32 Credits = 0;
+	FOrbitalCargoLedger Cargo;
+	TStaticArray<int32, FOrbitalUpgradeRules::NumUpgradeTypes> UpgradeLevels;
+
+	// Mission
+	EOrbitalMissionStage Stage = EOrbitalMissionStage::RetrieveBlackBox;
+	bool bHasRecoveredBlackBox = false;
+
+	// Sector
+	EOrbitalSectorId Sector = EOrbitalSectorId::Belt;
+	FVector2D StationLocation = FVector2D::ZeroVector;
+	bool bStationIsBeacon = false;
+	FVector2D GateLocation = FVector2D::ZeroVector;
+	EOrbitalSectorId GateTarget = EOrbitalSectorId::Ruins;
+	TArray<FNode> Nodes;
+	TArray<FDrone> Drones;
+	int32 TargetNode = INDEX_NONE;
+
+	void EnterSector(EOrbitalSectorId NewSector);
+	void Step(float DeltaSeconds);
+
+	EPilotGoal ChooseGoal() const;
+	bool MoveTowards(const FVector2D& Destination, float StopDistance, float DeltaSeconds);
+	void MineTarget(float DeltaSeconds);
+	bool FireBeamAtDrones(float DeltaSeconds);
+	bool FireBeam(float DeltaSeconds);
+	void Dock();
+	void BuyUpgrades();
+	void Jump();
+	void SimulateDrones(float DeltaSeconds);
+
+	int32 FindMiningTarget() const;
+	bool TryConsumePower(float Amount);
+	bool TryConsumeFuel(float Amount);
+	int32 GetUpgradeLevel(EOrbitalUpgradeType UpgradeType) const { return UpgradeLevels[static_cast<int32>(UpgradeType)]; }
+};
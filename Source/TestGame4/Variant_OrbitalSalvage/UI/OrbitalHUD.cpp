@@ -8,9 +8,14 @@
 #include "Engine/Canvas.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_OrbitalHUDDraw, STATGROUP_OrbitalSalvage);
 
 void AOrbitalHUD::DrawHUD()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_OrbitalHUDDraw);
+
 	Super::DrawHUD();
 
 	AOrbitalGameMode* GM = GetWorld() ? GetWorld()->GetAuthGameMode<AOrbitalGameMode>() : nullptr;
@@ -31,13 +36,13 @@ void AOrbitalHUD::DrawHUD()
 	DrawText(Header, FColor::Cyan, X, Y, GEngine->GetLargeFont());
 	Y += 30.0f;
 
-	DrawText(FString::Printf(TEXT("Hull: %.0f / %.0f"), Systems->Hull, Systems->MaxHull), FColor::White, X, Y);
+	DrawText(FString::Printf(TEXT("Hull: %.0f / %.0f"), Systems->GetHull(), Systems->MaxHull), FColor::White, X, Y);
 	Y += 18.0f;
 	DrawText(FString::Printf(TEXT("Fuel: %.0f / %.0f"), Systems->Fuel, Systems->MaxFuel), FColor::White, X, Y);
 	Y += 18.0f;
-	DrawText(FString::Printf(TEXT("Power: %.0f / %.0f"), Systems->CurrentPower, Systems->MaxPower), FColor::White, X, Y);
+	DrawText(FString::Printf(TEXT("Power: %.0f / %.0f"), Systems->GetCurrentPower(), Systems->MaxPower), FColor::White, X, Y);
 	Y += 18.0f;
-	DrawText(FString::Printf(TEXT("Heat: %.0f / %.0f"), Systems->Heat, Systems->MaxHeat), FColor::White, X, Y);
+	DrawText(FString::Printf(TEXT("Heat: %.0f / %.0f"), Systems->GetHeat(), Systems->MaxHeat), FColor::White, X, Y);
 	Y += 18.0f;
 	DrawText(FString::Printf(TEXT("Cargo: %.0f / %.0f"), Systems->CargoUsed, Systems->CargoCapacity), FColor::White, X, Y);
 	Y += 18.0f;
@@ -5,8 +5,15 @@
 #include "CrewNeedsComponent.h"
 #include "StationModule.h"
 #include "SpaceStationGameMode.h"
+#include "StationSystemsComponent.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crew AI Tick"), STAT_StationCrewAITick, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Crew Evaluate Needs"), STAT_StationCrewEvaluateNeeds, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Crew Need Lookup"), STAT_StationCrewNeedLookup, STATGROUP_SpaceStation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Need Lookups"), STAT_StationNeedLookups, STATGROUP_SpaceStation);
 
 ACrewAIController::ACrewAIController()
 {
@@ -21,6 +28,8 @@ void ACrewAIController::OnPossess(APawn* InPawn)
 
 void ACrewAIController::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewAITick);
+
 	Super::Tick(DeltaSeconds);
 
 	if (!CrewMember || !CrewMember->IsAlive())
@@ -110,6 +119,8 @@ void ACrewAIController::CommandMoveToModule(AStationModule* Module)
 
 void ACrewAIController::EvaluateNeeds()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewEvaluateNeeds);
+
 	if (!CrewMember)
 		return;
 
@@ -280,58 +291,43 @@ AStationModule* ACrewAIController::FindNearestQuarters() const
 
 AStationModule* ACrewAIController::FindNearestModuleForNeed(ECrewNeedType NeedType) const
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewNeedLookup);
+	INC_DWORD_STAT(STAT_StationNeedLookups);
+
 	if (!CrewMember)
 		return nullptr;
 
-	TArray<AStationModule*> Modules = GetAllModules();
-	AStationModule* NearestModule = nullptr;
-	float NearestDistance = MAX_FLT;
-	FVector CrewLocation = CrewMember->GetActorLocation();
-
-	for (AStationModule* Module : Modules)
+	// Each need is served by exactly one module type
+	EStationModuleType ModuleType;
+	switch (NeedType)
 	{
-		if (!Module || !Module->bIsPlaced || !Module->bIsPowered)
-			continue;
-
-		bool bMatchesNeed = false;
-		switch (NeedType)
-		{
-		case ECrewNeedType::Oxygen:
-			// Life support modules generate oxygen
-			bMatchesNeed = (Module->ModuleType == EStationModuleType::LifeSupport && Module->bHasAtmosphere);
-			break;
-		case ECrewNeedType::Food:
-			// Mess hall or modules with food capability
-			bMatchesNeed = (Module->ModuleType == EStationModuleType::MessHall && Module->bHasAtmosphere);
-			break;
-		case ECrewNeedType::Sleep:
-			// Quarters for sleeping
-			bMatchesNeed = (Module->ModuleType == EStationModuleType::Quarters && Module->bHasAtmosphere);
-			break;
-		default:
-			break;
-		}
-
-		if (bMatchesNeed)
-		{
-			float Distance = FVector::Dist2D(CrewLocation, Module->GetActorLocation());
-			if (Distance < NearestDistance)
-			{
-				NearestDistance = Distance;
-				NearestModule = Module;
-			}
-		}
+	case ECrewNeedType::Oxygen:
+		// Life support modules generate oxygen
+		ModuleType = EStationModuleType::LifeSupport;
+		break;
+	case ECrewNeedType::Food:
+		// Mess hall or modules with food capability
+		ModuleType = EStationModuleType::MessHall;
+		break;
+	case ECrewNeedType::Sleep:
+		// Quarters for sleeping
+		ModuleType = EStationModuleType::Quarters;
+		break;
+	default:
+		return nullptr;
 	}
 
-	return NearestModule;
+	// Shortest walk through the station, not straight-line distance, so crew don't pick modules they can't easily reach
+	UStationSystemsComponent* Systems = GetStationSystems();
+	return Systems ? Systems->FindNearestReachableModule(ModuleType, CrewMember->GetActorLocation()) : nullptr;
 }
 
-TArray<AStationModule*> ACrewAIController::GetAllModules() const
+UStationSystemsComponent* ACrewAIController::GetStationSystems() const
 {
 	ASpaceStationGameMode* GM = Cast<ASpaceStationGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
 	if (GM)
 	{
-		return GM->GetAllModules();
+		return GM->GetStationSystems();
 	}
-	return TArray<AStationModule*>();
+	return nullptr;
 }
@@ -5,10 +5,11 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "CrewNeedsComponent.h"
+#include "StationModule.h"
 #include "CrewAIController.generated.h"
 
 class ACrewMember;
-class AStationModule;
+class UStationSystemsComponent;
 
 /**
  * Enum for crew AI states.
@@ -127,6 +128,6 @@ private:
 	/** Has the player issued a manual command */
 	bool bHasPlayerCommand = false;
 
-	/** Get all modules from game mode */
-	TArray<AStationModule*> GetAllModules() const;
+	/** Helper: Get the station systems component from the GameMode */
+	UStationSystemsComponent* GetStationSystems() const;
 };
@@ -1,89 +1,33 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CrewNeedsComponent.h"
+#include "CrewSimulationSubsystem.h"
+#include "Engine/World.h"
 
 UCrewNeedsComponent::UCrewNeedsComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Needs are simulated in batch by UCrewSimulationSubsystem
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
-void UCrewNeedsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UCrewNeedsComponent::BeginPlay()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	Super::BeginPlay();
 
-	if (!bIsAlive)
-		return;
-
-	TickNeeds(DeltaTime);
-	TickHealth(DeltaTime);
-}
-
-void UCrewNeedsComponent::TickNeeds(float DeltaTime)
-{
-	// Oxygen depletes faster when not in atmosphere
-	if (!bInAtmosphere)
-	{
-		Oxygen = FMath::Max(0.0f, Oxygen - OxygenDepletionRate * DeltaTime);
-	}
-	else
-	{
-		// Slowly deplete even in atmosphere (need life support to fully sustain)
-		Oxygen = FMath::Max(0.0f, Oxygen - OxygenDepletionRate * 0.25f * DeltaTime);
-	}
-
-	// Food always depletes
-	Food = FMath::Max(0.0f, Food - FoodDepletionRate * DeltaTime);
-
-	// Sleep always depletes
-	Sleep = FMath::Max(0.0f, Sleep - SleepDepletionRate * DeltaTime);
-
-	// Check for critical transitions and fire events
-	bool bOxygenCritical = IsNeedCritical(ECrewNeedType::Oxygen);
-	bool bFoodCritical = IsNeedCritical(ECrewNeedType::Food);
-	bool bSleepCritical = IsNeedCritical(ECrewNeedType::Sleep);
-
-	if (bOxygenCritical && !bWasOxygenCritical)
+	if (UCrewSimulationSubsystem* Simulation = GetSimulation())
 	{
-		BP_NeedCritical(ECrewNeedType::Oxygen);
+		Simulation->RegisterCrew(this);
 	}
-	if (bFoodCritical && !bWasFoodCritical)
-	{
-		BP_NeedCritical(ECrewNeedType::Food);
-	}
-	if (bSleepCritical && !bWasSleepCritical)
-	{
-		BP_NeedCritical(ECrewNeedType::Sleep);
-	}
-
-	bWasOxygenCritical = bOxygenCritical;
-	bWasFoodCritical = bFoodCritical;
-	bWasSleepCritical = bSleepCritical;
 }
 
-void UCrewNeedsComponent::TickHealth(float DeltaTime)
+void UCrewNeedsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Health depletes when critical needs aren't met
-	if (IsNeedCritical(ECrewNeedType::Oxygen))
+	if (UCrewSimulationSubsystem* Simulation = GetSimulation())
 	{
-		Health = FMath::Max(0.0f, Health - HealthDepletionFromOxygen * DeltaTime);
-	}
-	if (IsNeedCritical(ECrewNeedType::Food))
-	{
-		Health = FMath::Max(0.0f, Health - HealthDepletionFromFood * DeltaTime);
-	}
-
-	// Health regenerates when all needs are above critical
-	if (!HasAnyCriticalNeed() && Health < 100.0f)
-	{
-		Health = FMath::Min(100.0f, Health + HealthRegenRate * DeltaTime);
+		Simulation->UnregisterCrew(this);
 	}
 
-	// Death check
-	if (Health <= 0.0f && bIsAlive)
-	{
-		bIsAlive = false;
-		BP_CrewDied();
-	}
+	Super::EndPlay(EndPlayReason);
 }
 
 float UCrewNeedsComponent::GetNeedValue(ECrewNeedType NeedType) const
@@ -138,19 +82,39 @@ bool UCrewNeedsComponent::HasAnyCriticalNeed() const
 void UCrewNeedsComponent::ReplenishOxygen(float DeltaTime)
 {
 	Oxygen = FMath::Min(100.0f, Oxygen + OxygenReplenishRate * DeltaTime);
+	NotifyNeedsChanged();
 }
 
 void UCrewNeedsComponent::ReplenishFood(float DeltaTime)
 {
 	Food = FMath::Min(100.0f, Food + FoodReplenishRate * DeltaTime);
+	NotifyNeedsChanged();
 }
 
 void UCrewNeedsComponent::ReplenishSleep(float DeltaTime)
 {
 	Sleep = FMath::Min(100.0f, Sleep + SleepReplenishRate * DeltaTime);
+	NotifyNeedsChanged();
 }
 
 void UCrewNeedsComponent::SetInAtmosphere(bool bHasAtmosphere)
 {
 	bInAtmosphere = bHasAtmosphere;
 }
+
+void UCrewNeedsComponent::NotifyNeedsChanged()
+{
+	if (SimulationIndex == INDEX_NONE)
+		return;
+
+	if (UCrewSimulationSubsystem* Simulation = GetSimulation())
+	{
+		Simulation->PushNeeds(this);
+	}
+}
+
+UCrewSimulationSubsystem* UCrewNeedsComponent::GetSimulation() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UCrewSimulationSubsystem>() : nullptr;
+}
@@ -6,6 +6,8 @@
 #include "Components/ActorComponent.h"
 #include "CrewNeedsComponent.generated.h"
 
+class UCrewSimulationSubsystem;
+
 /**
  * Enum for the different crew need types.
  */
@@ -22,6 +24,7 @@ enum class ECrewNeedType : uint8
  * Manages individual crew member survival needs.
  * Tracks oxygen, food, sleep, and health values that deplete over time
  * and can be replenished at appropriate station modules.
+ * Depletion is simulated in batch by UCrewSimulationSubsystem; this component does not tick.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class UCrewNeedsComponent : public UActorComponent
@@ -32,7 +35,8 @@ public:
 
 	UCrewNeedsComponent();
 
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Need Values (0-100)
 
@@ -160,16 +164,17 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category="Needs")
 	void BP_CrewDied();
 
+	/** Call after changing need values or rates at runtime so the batched simulation picks up the change */
+	UFUNCTION(BlueprintCallable, Category="Needs")
+	void NotifyNeedsChanged();
+
 private:
 
-	/** Deplete needs over time */
-	void TickNeeds(float DeltaTime);
+	friend class UCrewSimulationSubsystem;
 
-	/** Update health based on other needs */
-	void TickHealth(float DeltaTime);
+	/** Slot in the crew simulation's arrays, or INDEX_NONE when not registered */
+	int32 SimulationIndex = INDEX_NONE;
 
-	/** Track previous critical states to fire events only on change */
-	bool bWasOxygenCritical = false;
-	bool bWasFoodCritical = false;
-	bool bWasSleepCritical = false;
+	/** Helper: Get the batched crew simulation for this world */
+	UCrewSimulationSubsystem* GetSimulation() const;
 };
@@ -0,0 +1,364 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationAtmosphereGraph.h"
+#include "StationModule.h"
+
+void FStationAtmosphereGraph::AddModule(AStationModule* Module, bool bIsAtmosphereSource)
+{
+	if (!Module || NodeIndices.Contains(Module))
+		return;
+
+	int32 NodeIndex;
+	if (FreeNodes.Num() > 0)
+	{
+		NodeIndex = FreeNodes.Pop(EAllowShrinking::No);
+		Nodes[NodeIndex] = FNode();
+	}
+	else
+	{
+		NodeIndex = Nodes.AddDefaulted();
+	}
+
+	NodeIndices.Add(Module, NodeIndex);
+	Nodes[NodeIndex].Module = Module;
+	Nodes[NodeIndex].bIsAtmosphereSource = bIsAtmosphereSource;
+
+	// Link to neighbours that are already part of the graph (the grid has updated connections both ways)
+	for (const AStationModule* Connected : Module->ConnectedModules)
+	{
+		const int32* OtherIndex = NodeIndices.Find(Connected);
+		if (OtherIndex && *OtherIndex != NodeIndex && !Nodes[NodeIndex].Links.Contains(*OtherIndex))
+		{
+			Nodes[NodeIndex].Links.Add(*OtherIndex);
+			Nodes[*OtherIndex].Links.Add(NodeIndex);
+		}
+	}
+
+	// Start as a component of one, then union with every neighbouring component
+	int32 ComponentIndex = AllocateComponent();
+	AddMember(ComponentIndex, NodeIndex);
+	Components[ComponentIndex].NumSources = bIsAtmosphereSource ? 1 : 0;
+
+	for (int32 LinkIndex = 0; LinkIndex < Nodes[NodeIndex].Links.Num(); ++LinkIndex)
+	{
+		const int32 Neighbor = Nodes[NodeIndex].Links[LinkIndex];
+		ComponentIndex = MergeComponents(ComponentIndex, Nodes[Neighbor].Component);
+	}
+
+	WriteAtmosphere(Module, Components[ComponentIndex].HasAtmosphere());
+}
+
+void FStationAtmosphereGraph::RemoveModule(AStationModule* Module)
+{
+	int32 NodeIndex;
+	if (!Module || !NodeIndices.RemoveAndCopyValue(Module, NodeIndex))
+		return;
+
+	const int32 ComponentIndex = Nodes[NodeIndex].Component;
+	const bool bHadAtmosphere = Components[ComponentIndex].HasAtmosphere();
+
+	if (Nodes[NodeIndex].bIsAtmosphereSource)
+	{
+		--Components[ComponentIndex].NumSources;
+	}
+
+	const TArray<int32, TInlineAllocator<4>> Neighbors = MoveTemp(Nodes[NodeIndex].Links);
+	for (int32 Neighbor : Neighbors)
+	{
+		Nodes[Neighbor].Links.RemoveSingleSwap(NodeIndex);
+	}
+
+	RemoveMember(NodeIndex);
+	Nodes[NodeIndex] = FNode();
+	FreeNodes.Add(NodeIndex);
+
+	if (Components[ComponentIndex].Members.Num() == 0)
+	{
+		ReleaseComponent(ComponentIndex);
+		return;
+	}
+
+	// With two or more former neighbours the component may have split. Grow one breadth-first search
+	// per neighbour in lockstep; searches that meet join a group. A group whose searches all run dry
+	// is a separate piece, and once only one group is still growing it must be the rest of the component.
+	if (Neighbors.Num() > 1)
+	{
+		struct FSearch
+		{
+			/** Every node reached so far; also the queue, with Head as the next node to expand */
+			TArray<int32> Visited;
+			int32 Head = 0;
+			int32 Group = INDEX_NONE;
+
+			bool IsGrowing() const { return Head < Visited.Num(); }
+		};
+
+		++SearchStamp;
+
+		TArray<FSearch, TInlineAllocator<4>> Searches;
+		Searches.SetNum(Neighbors.Num());
+		for (int32 SearchIndex = 0; SearchIndex < Neighbors.Num(); ++SearchIndex)
+		{
+			FNode& Start = Nodes[Neighbors[SearchIndex]];
+			Start.SearchStamp = SearchStamp;
+			Start.SearchIndex = SearchIndex;
+			Searches[SearchIndex].Visited.Add(Neighbors[SearchIndex]);
+			Searches[SearchIndex].Group = SearchIndex;
+		}
+
+		auto FindGroup = [&Searches](int32 SearchIndex)
+		{
+			while (Searches[SearchIndex].Group != SearchIndex)
+			{
+				SearchIndex = Searches[SearchIndex].Group;
+			}
+			return SearchIndex;
+		};
+
+		int32 GrowingGroup = INDEX_NONE;
+		while (true)
+		{
+			TArray<int32, TInlineAllocator<4>> GrowingGroups;
+			for (int32 SearchIndex = 0; SearchIndex < Searches.Num(); ++SearchIndex)
+			{
+				if (Searches[SearchIndex].IsGrowing())
+				{
+					GrowingGroups.AddUnique(FindGroup(SearchIndex));
+				}
+			}
+
+			if (GrowingGroups.Num() <= 1)
+			{
+				GrowingGroup = GrowingGroups.Num() == 1 ? GrowingGroups[0] : INDEX_NONE;
+				break;
+			}
+
+			for (int32 SearchIndex = 0; SearchIndex < Searches.Num(); ++SearchIndex)
+			{
+				FSearch& Search = Searches[SearchIndex];
+				if (!Search.IsGrowing())
+					continue;
+
+				const int32 Current = Search.Visited[Search.Head++];
+				for (int32 Link : Nodes[Current].Links)
+				{
+					FNode& LinkNode = Nodes[Link];
+					if (LinkNode.SearchStamp != SearchStamp)
+					{
+						LinkNode.SearchStamp = SearchStamp;
+						LinkNode.SearchIndex = SearchIndex;
+						Search.Visited.Add(Link);
+					}
+					else
+					{
+						const int32 GroupA = FindGroup(SearchIndex);
+						const int32 GroupB = FindGroup(LinkNode.SearchIndex);
+						if (GroupA != GroupB)
+						{
+							Searches[GroupB].Group = GroupA;
+						}
+					}
+				}
+			}
+		}
+
+		// Collect each finished group into a piece
+		TArray<int32, TInlineAllocator<4>> Groups;
+		TArray<TArray<int32>, TInlineAllocator<4>> Pieces;
+		for (int32 SearchIndex = 0; SearchIndex < Searches.Num(); ++SearchIndex)
+		{
+			const int32 Group = FindGroup(SearchIndex);
+			if (Group == GrowingGroup)
+				continue;
+
+			int32 PieceIndex = Groups.Find(Group);
+			if (PieceIndex == INDEX_NONE)
+			{
+				PieceIndex = Groups.Add(Group);
+				Pieces.AddDefaulted();
+			}
+			Pieces[PieceIndex].Append(Searches[SearchIndex].Visited);
+		}
+
+		// If every search ran dry, the largest piece keeps the original component
+		if (GrowingGroup == INDEX_NONE && Pieces.Num() > 0)
+		{
+			int32 LargestPiece = 0;
+			for (int32 PieceIndex = 1; PieceIndex < Pieces.Num(); ++PieceIndex)
+			{
+				if (Pieces[PieceIndex].Num() > Pieces[LargestPiece].Num())
+				{
+					LargestPiece = PieceIndex;
+				}
+			}
+			Pieces.RemoveAtSwap(LargestPiece);
+		}
+
+		for (const TArray<int32>& Piece : Pieces)
+		{
+			const int32 PieceComponent = SplitOff(Piece);
+			if (Components[PieceComponent].HasAtmosphere() != bHadAtmosphere)
+			{
+				PushAtmosphere(PieceComponent);
+			}
+		}
+	}
+
+	if (Components[ComponentIndex].HasAtmosphere() != bHadAtmosphere)
+	{
+		PushAtmosphere(ComponentIndex);
+	}
+}
+
+void FStationAtmosphereGraph::SetAtmosphereSource(AStationModule* Module, bool bIsAtmosphereSource)
+{
+	const int32* NodeIndex = NodeIndices.Find(Module);
+	if (!NodeIndex || Nodes[*NodeIndex].bIsAtmosphereSource == bIsAtmosphereSource)
+		return;
+
+	Nodes[*NodeIndex].bIsAtmosphereSource = bIsAtmosphereSource;
+
+	const int32 ComponentIndex = Nodes[*NodeIndex].Component;
+	const bool bHadAtmosphere = Components[ComponentIndex].HasAtmosphere();
+	Components[ComponentIndex].NumSources += bIsAtmosphereSource ? 1 : -1;
+
+	if (Components[ComponentIndex].HasAtmosphere() != bHadAtmosphere)
+	{
+		PushAtmosphere(ComponentIndex);
+	}
+}
+
+void FStationAtmosphereGraph::Reset()
+{
+	Nodes.Reset();
+	FreeNodes.Reset();
+	NodeIndices.Reset();
+	Components.Reset();
+	FreeComponents.Reset();
+}
+
+bool FStationAtmosphereGraph::HasAtmosphere(const AStationModule* Module) const
+{
+	const int32* NodeIndex = NodeIndices.Find(Module);
+	return NodeIndex && Components[Nodes[*NodeIndex].Component].HasAtmosphere();
+}
+
+int32 FStationAtmosphereGraph::GetComponentId(const AStationModule* Module) const
+{
+	const int32* NodeIndex = NodeIndices.Find(Module);
+	return NodeIndex ? Nodes[*NodeIndex].Component : INDEX_NONE;
+}
+
+int32 FStationAtmosphereGraph::AllocateComponent()
+{
+	if (FreeComponents.Num() > 0)
+	{
+		return FreeComponents.Pop(EAllowShrinking::No);
+	}
+
+	return Components.AddDefaulted();
+}
+
+void FStationAtmosphereGraph::ReleaseComponent(int32 ComponentIndex)
+{
+	Components[ComponentIndex].Members.Reset();
+	Components[ComponentIndex].NumSources = 0;
+	FreeComponents.Add(ComponentIndex);
+}
+
+void FStationAtmosphereGraph::AddMember(int32 ComponentIndex, int32 NodeIndex)
+{
+	Nodes[NodeIndex].Component = ComponentIndex;
+	Nodes[NodeIndex].MemberIndex = Components[ComponentIndex].Members.Add(NodeIndex);
+}
+
+void FStationAtmosphereGraph::RemoveMember(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	TArray<int32>& Members = Components[Node.Component].Members;
+
+	Members.RemoveAtSwap(Node.MemberIndex, EAllowShrinking::No);
+	if (Members.IsValidIndex(Node.MemberIndex))
+	{
+		Nodes[Members[Node.MemberIndex]].MemberIndex = Node.MemberIndex;
+	}
+
+	Node.Component = INDEX_NONE;
+	Node.MemberIndex = INDEX_NONE;
+}
+
+int32 FStationAtmosphereGraph::MergeComponents(int32 ComponentA, int32 ComponentB)
+{
+	if (ComponentA == ComponentB)
+		return ComponentA;
+
+	// Union by size: only the smaller component's members are relabelled
+	const bool bAIsLarger = Components[ComponentA].Members.Num() >= Components[ComponentB].Members.Num();
+	const int32 Larger = bAIsLarger ? ComponentA : ComponentB;
+	const int32 Smaller = bAIsLarger ? ComponentB : ComponentA;
+
+	const bool bLargerHadAtmosphere = Components[Larger].HasAtmosphere();
+	const bool bSmallerHadAtmosphere = Components[Smaller].HasAtmosphere();
+
+	const int32 FirstMoved = Components[Larger].Members.Num();
+	for (int32 NodeIndex : Components[Smaller].Members)
+	{
+		AddMember(Larger, NodeIndex);
+	}
+	Components[Larger].NumSources += Components[Smaller].NumSources;
+	ReleaseComponent(Smaller);
+
+	const bool bHasAtmosphere = Components[Larger].HasAtmosphere();
+	if (bHasAtmosphere != bLargerHadAtmosphere)
+	{
+		PushAtmosphere(Larger);
+	}
+	else if (bHasAtmosphere != bSmallerHadAtmosphere)
+	{
+		const TArray<int32>& Members = Components[Larger].Members;
+		for (int32 MemberIndex = FirstMoved; MemberIndex < Members.Num(); ++MemberIndex)
+		{
+			WriteAtmosphere(Nodes[Members[MemberIndex]].Module, bHasAtmosphere);
+		}
+	}
+
+	return Larger;
+}
+
+int32 FStationAtmosphereGraph::SplitOff(TConstArrayView<int32> PieceNodes)
+{
+	const int32 NewComponent = AllocateComponent();
+	for (int32 NodeIndex : PieceNodes)
+	{
+		const int32 OldComponent = Nodes[NodeIndex].Component;
+		if (Nodes[NodeIndex].bIsAtmosphereSource)
+		{
+			--Components[OldComponent].NumSources;
+			++Components[NewComponent].NumSources;
+		}
+
+		RemoveMember(NodeIndex);
+		AddMember(NewComponent, NodeIndex);
+	}
+
+	return NewComponent;
+}
+
+void FStationAtmosphereGraph::PushAtmosphere(int32 ComponentIndex) const
+{
+	const FComponent& Component = Components[ComponentIndex];
+	const bool bHasAtmosphere = Component.HasAtmosphere();
+	for (int32 NodeIndex : Component.Members)
+	{
+		WriteAtmosphere(Nodes[NodeIndex].Module, bHasAtmosphere);
+	}
+}
+
+void FStationAtmosphereGraph::WriteAtmosphere(AStationModule* Module, bool bHasAtmosphere) const
+{
+	if (Module->bHasAtmosphere == bHasAtmosphere)
+		return;
+
+	Module->bHasAtmosphere = bHasAtmosphere;
+	OnAtmosphereChanged.ExecuteIfBound(Module);
+}
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AStationModule;
+
+/** Fired for each module whose atmosphere flag the graph has just changed */
+DECLARE_DELEGATE_OneParam(FOnStationModuleAtmosphereChanged, AStationModule*);
+
+/**
+ * Connected components of the station's module graph, maintained incrementally.
+ * A module has atmosphere exactly when its component contains at least one atmosphere source
+ * (a powered life support module), so each component keeps a count of its sources.
+ *
+ * Adding a module merges the components it touches, relabelling the smaller into the larger.
+ * Removing a module searches outward from its former neighbours in lockstep and stops as soon
+ * as only one search is still growing, so a split costs the size of the pieces that broke off.
+ * Atmosphere flags are written to modules only when their component gains or loses its last source.
+ */
+class FStationAtmosphereGraph
+{
+public:
+
+	/** Adds a placed module and links it to every already added module in its ConnectedModules */
+	void AddModule(AStationModule* Module, bool bIsAtmosphereSource);
+
+	/** Removes a module and splits its component if it was the only link between parts */
+	void RemoveModule(AStationModule* Module);
+
+	/** Updates whether a module currently supplies atmosphere (powered life support) */
+	void SetAtmosphereSource(AStationModule* Module, bool bIsAtmosphereSource);
+
+	/** Drops every module without touching their atmosphere flags */
+	void Reset();
+
+	bool Contains(const AStationModule* Module) const { return NodeIndices.Contains(Module); }
+
+	/** Returns true if the module's component has a powered life support module */
+	bool HasAtmosphere(const AStationModule* Module) const;
+
+	/** Returns an id shared by all modules connected to this one, or INDEX_NONE if it is not in the graph */
+	int32 GetComponentId(const AStationModule* Module) const;
+
+	int32 GetNumComponents() const { return Components.Num() - FreeComponents.Num(); }
+
+	/** Lets the owner keep state derived from bHasAtmosphere in sync without rescanning modules */
+	FOnStationModuleAtmosphereChanged OnAtmosphereChanged;
+
+private:
+
+	struct FNode
+	{
+		AStationModule* Module = nullptr;
+		int32 Component = INDEX_NONE;
+
+		/** Position of this node in its component's Members */
+		int32 MemberIndex = INDEX_NONE;
+
+		bool bIsAtmosphereSource = false;
+
+		/** Search bookkeeping for splits; valid while SearchStamp matches the graph's */
+		uint32 SearchStamp = 0;
+		int32 SearchIndex = INDEX_NONE;
+
+		TArray<int32, TInlineAllocator<4>> Links;
+	};
+
+	struct FComponent
+	{
+		TArray<int32> Members;
+		int32 NumSources = 0;
+
+		bool HasAtmosphere() const { return NumSources > 0; }
+	};
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	TMap<const AStationModule*, int32> NodeIndices;
+
+	TArray<FComponent> Components;
+	TArray<int32> FreeComponents;
+
+	uint32 SearchStamp = 0;
+
+	int32 AllocateComponent();
+	void ReleaseComponent(int32 ComponentIndex);
+
+	void AddMember(int32 ComponentIndex, int32 NodeIndex);
+	void RemoveMember(int32 NodeIndex);
+
+	/** Moves every member of the smaller component into the larger one and returns the survivor */
+	int32 MergeComponents(int32 ComponentA, int32 ComponentB);
+
+	/** Moves the given nodes out of their component into a new one and returns it */
+	int32 SplitOff(TConstArrayView<int32> PieceNodes);
+
+	/** Writes the component's atmosphere state to all of its modules */
+	void PushAtmosphere(int32 ComponentIndex) const;
+
+	/** Writes one module's atmosphere flag and notifies OnAtmosphereChanged if it changed */
+	void WriteAtmosphere(AStationModule* Module, bool bHasAtmosphere) const;
+};
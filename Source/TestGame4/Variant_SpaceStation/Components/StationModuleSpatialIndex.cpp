@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationModuleSpatialIndex.h"
+
+FStationModuleSpatialIndex::FStationModuleSpatialIndex(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+void FStationModuleSpatialIndex::Update(AStationModule* Module, bool bInclude)
+{
+	if (!Module)
+		return;
+
+	if (!bInclude)
+	{
+		Remove(Module);
+		return;
+	}
+
+	if (Slots.Contains(Module))
+		return;
+
+	const FVector2D Location(Module->GetActorLocation());
+
+	FSlot& Slot = Slots.Add(Module);
+	Slot.Cell = ToCell(Location);
+	Slot.ModuleType = Module->ModuleType;
+
+	FTypeGrid& Grid = Grids[static_cast<int32>(Slot.ModuleType)];
+	if (Grid.Num == 0)
+	{
+		Grid.MinCell = Slot.Cell;
+		Grid.MaxCell = Slot.Cell;
+	}
+	else
+	{
+		Grid.MinCell = FIntPoint(FMath::Min(Grid.MinCell.X, Slot.Cell.X), FMath::Min(Grid.MinCell.Y, Slot.Cell.Y));
+		Grid.MaxCell = FIntPoint(FMath::Max(Grid.MaxCell.X, Slot.Cell.X), FMath::Max(Grid.MaxCell.Y, Slot.Cell.Y));
+	}
+
+	FEntry& Entry = Grid.Cells.FindOrAdd(Slot.Cell).AddDefaulted_GetRef();
+	Entry.Module = Module;
+	Entry.Location = Location;
+	++Grid.Num;
+}
+
+void FStationModuleSpatialIndex::Remove(const AStationModule* Module)
+{
+	FSlot Slot;
+	if (!Module || !Slots.RemoveAndCopyValue(Module, Slot))
+		return;
+
+	FTypeGrid& Grid = Grids[static_cast<int32>(Slot.ModuleType)];
+	if (TArray<FEntry, TInlineAllocator<2>>* Entries = Grid.Cells.Find(Slot.Cell))
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Entries->Num(); ++EntryIndex)
+		{
+			if ((*Entries)[EntryIndex].Module == Module)
+			{
+				Entries->RemoveAtSwap(EntryIndex, EAllowShrinking::No);
+				break;
+			}
+		}
+
+		if (Entries->IsEmpty())
+		{
+			Grid.Cells.Remove(Slot.Cell);
+		}
+	}
+
+	--Grid.Num;
+}
+
+void FStationModuleSpatialIndex::Reset()
+{
+	Slots.Reset();
+	for (FTypeGrid& Grid : Grids)
+	{
+		Grid = FTypeGrid();
+	}
+}
+
+AStationModule* FStationModuleSpatialIndex::FindNearest(EStationModuleType ModuleType, const FVector& Location) const
+{
+	const FTypeGrid& Grid = Grids[static_cast<int32>(ModuleType)];
+	if (Grid.Num == 0)
+		return nullptr;
+
+	const FVector2D Point(Location);
+	const FIntPoint Center = ToCell(Point);
+
+	AStationModule* Best = nullptr;
+	double BestDistSq = TNumericLimits<double>::Max();
+
+	auto ScanCell = [&](int32 CellX, int32 CellY)
+	{
+		const TArray<FEntry, TInlineAllocator<2>>* Entries = Grid.Cells.Find(FIntPoint(CellX, CellY));
+		if (!Entries)
+			return;
+
+		for (const FEntry& Entry : *Entries)
+		{
+			const double DistSq = FVector2D::DistSquared(Entry.Location, Point);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				Best = Entry.Module;
+			}
+		}
+	};
+
+	// Rings closer than the bounds are empty and rings past them hold nothing
+	const int32 FirstRing = FMath::Max(0, FMath::Max(
+		FMath::Max(Grid.MinCell.X - Center.X, Center.X - Grid.MaxCell.X),
+		FMath::Max(Grid.MinCell.Y - Center.Y, Center.Y - Grid.MaxCell.Y)));
+	const int32 LastRing = FMath::Max(
+		FMath::Max(Center.X - Grid.MinCell.X, Grid.MaxCell.X - Center.X),
+		FMath::Max(Center.Y - Grid.MinCell.Y, Grid.MaxCell.Y - Center.Y));
+
+	for (int32 Ring = FirstRing; Ring <= LastRing; ++Ring)
+	{
+		if (Best && Ring > 0)
+		{
+			// Everything in this ring lies outside the square of cells within Ring - 1 of the centre cell
+			const double InnerMinX = (Center.X - Ring + 1) * static_cast<double>(CellSize);
+			const double InnerMaxX = (Center.X + Ring) * static_cast<double>(CellSize);
+			const double InnerMinY = (Center.Y - Ring + 1) * static_cast<double>(CellSize);
+			const double InnerMaxY = (Center.Y + Ring) * static_cast<double>(CellSize);
+			const double Clearance = FMath::Min(
+				FMath::Min(Point.X - InnerMinX, InnerMaxX - Point.X),
+				FMath::Min(Point.Y - InnerMinY, InnerMaxY - Point.Y));
+
+			if (FMath::Square(Clearance) >= BestDistSq)
+				break;
+		}
+
+		const int32 MinX = FMath::Max(Center.X - Ring, Grid.MinCell.X);
+		const int32 MaxX = FMath::Min(Center.X + Ring, Grid.MaxCell.X);
+		const int32 MinY = FMath::Max(Center.Y - Ring, Grid.MinCell.Y);
+		const int32 MaxY = FMath::Min(Center.Y + Ring, Grid.MaxCell.Y);
+
+		for (int32 CellY = MinY; CellY <= MaxY; ++CellY)
+		{
+			if (CellY == Center.Y - Ring || CellY == Center.Y + Ring)
+			{
+				// Top and bottom rows of the ring
+				for (int32 CellX = MinX; CellX <= MaxX; ++CellX)
+				{
+					ScanCell(CellX, CellY);
+				}
+			}
+			else
+			{
+				// Left and right columns
+				if (Center.X - Ring >= Grid.MinCell.X)
+				{
+					ScanCell(Center.X - Ring, CellY);
+				}
+				if (Center.X + Ring <= Grid.MaxCell.X)
+				{
+					ScanCell(Center.X + Ring, CellY);
+				}
+			}
+		}
+	}
+
+	return Best;
+}
+
+FIntPoint FStationModuleSpatialIndex::ToCell(const FVector2D& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "StationModule.h"
+
+/**
+ * Uniform grid of station modules in the station plane, one grid per module type.
+ * Only modules the owner considers eligible are kept in it, so a nearest query never has to skip anything.
+ *
+ * Insertion and removal are O(1). A nearest query walks square rings of cells outward from the query point
+ * and stops once the next ring cannot hold anything closer than the best match so far, so its cost depends
+ * on the distance to the answer rather than on the number of modules in the station.
+ */
+class FStationModuleSpatialIndex
+{
+public:
+
+	/** Cell size in world units; modules are bucketed by their actor location */
+	explicit FStationModuleSpatialIndex(float InCellSize = 1600.0f);
+
+	/** Adds the module if bInclude is true and removes it otherwise; no-op if already in that state */
+	void Update(AStationModule* Module, bool bInclude);
+
+	void Remove(const AStationModule* Module);
+
+	void Reset();
+
+	bool Contains(const AStationModule* Module) const { return Slots.Contains(Module); }
+
+	int32 Num(EStationModuleType ModuleType) const { return Grids[static_cast<int32>(ModuleType)].Num; }
+
+	/** Returns the indexed module of the given type closest to Location in 2D, or nullptr if there is none */
+	AStationModule* FindNearest(EStationModuleType ModuleType, const FVector& Location) const;
+
+private:
+
+	struct FEntry
+	{
+		AStationModule* Module = nullptr;
+		FVector2D Location = FVector2D::ZeroVector;
+	};
+
+	/** Where a module was inserted, so removal does not depend on its current type or location */
+	struct FSlot
+	{
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		EStationModuleType ModuleType = EStationModuleType::Corridor;
+	};
+
+	struct FTypeGrid
+	{
+		TMap<FIntPoint, TArray<FEntry, TInlineAllocator<2>>> Cells;
+
+		/** Bounds of every cell ever used since the last reset; bounds the ring walk */
+		FIntPoint MinCell = FIntPoint::ZeroValue;
+		FIntPoint MaxCell = FIntPoint::ZeroValue;
+
+		int32 Num = 0;
+	};
+
+	float CellSize;
+
+	TStaticArray<FTypeGrid, NumStationModuleTypes> Grids;
+	TMap<const AStationModule*, FSlot> Slots;
+
+	FIntPoint ToCell(const FVector2D& Location) const;
+};
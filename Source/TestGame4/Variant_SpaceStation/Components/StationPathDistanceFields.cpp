@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationPathDistanceFields.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Path Field Update"), STAT_StationPathFieldUpdate, STATGROUP_SpaceStation);
+
+static const FIntPoint NeighborOffsets[] = {
+	FIntPoint(1, 0),   // Right
+	FIntPoint(-1, 0),  // Left
+	FIntPoint(0, 1),   // Forward
+	FIntPoint(0, -1)   // Backward
+};
+
+void FStationPathDistanceFields::TrackModuleType(EStationModuleType ModuleType)
+{
+	Fields[static_cast<int32>(ModuleType)].bTracked = true;
+}
+
+void FStationPathDistanceFields::AddModuleTiles(const AStationModule* Module)
+{
+	if (!Module)
+		return;
+
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationPathFieldUpdate);
+
+	TArray<FIntPoint, TInlineAllocator<8>> Footprint;
+	GetFootprint(Module, Footprint);
+
+	for (const FIntPoint& Tile : Footprint)
+	{
+		WalkableTiles.Add(Tile);
+	}
+
+	for (FField& Field : Fields)
+	{
+		if (!Field.bTracked || Field.Sources.Num() == 0)
+			continue;
+
+		// New tiles can only shorten paths, so spreading out from their reached neighbours is enough
+		Queue.Reset();
+		for (const FIntPoint& Tile : Footprint)
+		{
+			for (const FIntPoint& Offset : NeighborOffsets)
+			{
+				if (Field.Tiles.Contains(Tile + Offset))
+				{
+					Queue.Add(Tile + Offset);
+				}
+			}
+		}
+
+		Relax(Field);
+	}
+}
+
+void FStationPathDistanceFields::RemoveModuleTiles(AStationModule* Module)
+{
+	if (!Module)
+		return;
+
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationPathFieldUpdate);
+
+	TArray<FIntPoint, TInlineAllocator<8>> Footprint;
+	GetFootprint(Module, Footprint);
+
+	for (const FIntPoint& Tile : Footprint)
+	{
+		WalkableTiles.Remove(Tile);
+	}
+
+	for (FField& Field : Fields)
+	{
+		if (!Field.bTracked)
+			continue;
+
+		Field.Sources.Remove(Module);
+		Rebuild(Field);
+	}
+}
+
+void FStationPathDistanceFields::SetSource(AStationModule* Module, bool bIsSource)
+{
+	if (!Module)
+		return;
+
+	FField& Field = Fields[static_cast<int32>(Module->ModuleType)];
+	if (!Field.bTracked)
+		return;
+
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationPathFieldUpdate);
+
+	if (!bIsSource)
+	{
+		if (Field.Sources.Remove(Module) > 0)
+		{
+			RemoveSource(Field, Module);
+		}
+		return;
+	}
+
+	bool bAlreadySource = false;
+	Field.Sources.Add(Module, &bAlreadySource);
+	if (bAlreadySource)
+		return;
+
+	TArray<FIntPoint, TInlineAllocator<8>> Footprint;
+	GetFootprint(Module, Footprint);
+
+	Queue.Reset();
+	for (const FIntPoint& Tile : Footprint)
+	{
+		if (WalkableTiles.Contains(Tile))
+		{
+			Field.Tiles.Add(Tile, FFieldTile{ 0, Module });
+			Queue.Add(Tile);
+		}
+	}
+
+	Relax(Field);
+}
+
+void FStationPathDistanceFields::Reset()
+{
+	WalkableTiles.Reset();
+	for (FField& Field : Fields)
+	{
+		Field.Tiles.Reset();
+		Field.Sources.Reset();
+	}
+}
+
+AStationModule* FStationPathDistanceFields::FindNearest(EStationModuleType ModuleType, const FIntPoint& Tile, int32* OutDistance) const
+{
+	const FFieldTile* Entry = Fields[static_cast<int32>(ModuleType)].Tiles.Find(Tile);
+	if (!Entry)
+		return nullptr;
+
+	if (OutDistance)
+	{
+		*OutDistance = Entry->Distance;
+	}
+	return Entry->Target;
+}
+
+void FStationPathDistanceFields::GetFootprint(const AStationModule* Module, TArray<FIntPoint, TInlineAllocator<8>>& OutTiles)
+{
+	const FIntPoint Size = Module->GetRotatedSize(Module->GridRotation);
+	for (int32 X = 0; X < Size.X; ++X)
+	{
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			OutTiles.Add(Module->GridPosition + FIntPoint(X, Y));
+		}
+	}
+}
+
+void FStationPathDistanceFields::Rebuild(FField& Field)
+{
+	Field.Tiles.Reset();
+	Queue.Reset();
+
+	TArray<FIntPoint, TInlineAllocator<8>> Footprint;
+	for (AStationModule* Source : Field.Sources)
+	{
+		Footprint.Reset();
+		GetFootprint(Source, Footprint);
+
+		for (const FIntPoint& Tile : Footprint)
+		{
+			if (WalkableTiles.Contains(Tile))
+			{
+				Field.Tiles.Add(Tile, FFieldTile{ 0, Source });
+				Queue.Add(Tile);
+			}
+		}
+	}
+
+	Relax(Field);
+}
+
+void FStationPathDistanceFields::RemoveSource(FField& Field, AStationModule* Module)
+{
+	TArray<FIntPoint, TInlineAllocator<8>> Footprint;
+	GetFootprint(Module, Footprint);
+
+	// Every tile led to Module through a neighbour one step closer that also led to it,
+	// so the region is connected to the footprint and can be flood-cleared from there
+	Queue.Reset();
+	for (const FIntPoint& Tile : Footprint)
+	{
+		const FFieldTile* Entry = Field.Tiles.Find(Tile);
+		if (Entry && Entry->Target == Module)
+		{
+			Field.Tiles.Remove(Tile);
+			Queue.Add(Tile);
+		}
+	}
+
+	TArray<FIntPoint> Border;
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const FIntPoint Tile = Queue[Head];
+		for (const FIntPoint& Offset : NeighborOffsets)
+		{
+			const FIntPoint Next = Tile + Offset;
+			const FFieldTile* Entry = Field.Tiles.Find(Next);
+			if (!Entry)
+				continue;
+
+			if (Entry->Target == Module)
+			{
+				Field.Tiles.Remove(Next);
+				Queue.Add(Next);
+			}
+			else
+			{
+				Border.Add(Next);
+			}
+		}
+	}
+
+	// Refill the cleared region from the sources that still reach its edge
+	Queue = MoveTemp(Border);
+	Relax(Field);
+}
+
+void FStationPathDistanceFields::Relax(FField& Field)
+{
+	// Seeds can start at different distances; visiting them in order keeps this a plain BFS
+	Queue.Sort([&Field](const FIntPoint& A, const FIntPoint& B)
+	{
+		return Field.Tiles.FindChecked(A).Distance < Field.Tiles.FindChecked(B).Distance;
+	});
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const FFieldTile Current = Field.Tiles.FindChecked(Queue[Head]);
+		const FIntPoint Tile = Queue[Head];
+
+		for (const FIntPoint& Offset : NeighborOffsets)
+		{
+			const FIntPoint Next = Tile + Offset;
+			if (!WalkableTiles.Contains(Next))
+				continue;
+
+			FFieldTile& Entry = Field.Tiles.FindOrAdd(Next, FFieldTile{ MAX_int32, nullptr });
+			if (Entry.Distance <= Current.Distance + 1)
+				continue;
+
+			Entry.Distance = Current.Distance + 1;
+			Entry.Target = Current.Target;
+			Queue.Add(Next);
+		}
+	}
+
+	Queue.Reset();
+}
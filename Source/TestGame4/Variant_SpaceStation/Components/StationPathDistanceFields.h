@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "StationModule.h"
+
+/**
+ * Walking distance, in tiles, from every station tile to the closest source module of each tracked type.
+ * Tiles are the grid cells covered by placed modules and are linked to their four neighbours.
+ * Each tracked type keeps a multi-source BFS field storing the distance and the module it leads to,
+ * so "which module of this type is the shortest walk from here" is a single lookup.
+ *
+ * Fields are kept up to date incrementally:
+ * - a new source or new tiles only lower distances, so a BFS runs outward from them until nothing improves
+ * - a lost source clears just the region it was closest for and refills it from that region's border
+ * - removed tiles can lengthen any path, so each field is rebuilt (removal is a rare player action)
+ */
+class FStationPathDistanceFields
+{
+public:
+
+	/** Keep a field for this module type; call before any modules are added */
+	void TrackModuleType(EStationModuleType ModuleType);
+
+	/** Makes the module's footprint walkable */
+	void AddModuleTiles(const AStationModule* Module);
+
+	/** Removes the module's footprint and drops it as a source */
+	void RemoveModuleTiles(AStationModule* Module);
+
+	/** Starts or stops treating the module as a destination in its type's field */
+	void SetSource(AStationModule* Module, bool bIsSource);
+
+	void Reset();
+
+	bool IsWalkable(const FIntPoint& Tile) const { return WalkableTiles.Contains(Tile); }
+
+	/** Returns the closest source of the type by walking distance, or nullptr if none can be reached from Tile */
+	AStationModule* FindNearest(EStationModuleType ModuleType, const FIntPoint& Tile, int32* OutDistance = nullptr) const;
+
+private:
+
+	struct FFieldTile
+	{
+		int32 Distance = 0;
+		AStationModule* Target = nullptr;
+	};
+
+	struct FField
+	{
+		bool bTracked = false;
+		TMap<FIntPoint, FFieldTile> Tiles;
+		TSet<AStationModule*> Sources;
+	};
+
+	TSet<FIntPoint> WalkableTiles;
+	TStaticArray<FField, NumStationModuleTypes> Fields;
+
+	/** Reusable BFS queue */
+	TArray<FIntPoint> Queue;
+
+	/** Appends the tiles covered by a placed module */
+	static void GetFootprint(const AStationModule* Module, TArray<FIntPoint, TInlineAllocator<8>>& OutTiles);
+
+	/** Recomputes a field from its sources */
+	void Rebuild(FField& Field);
+
+	/** Drops every tile whose closest source was Module and refills them from the surrounding tiles */
+	void RemoveSource(FField& Field, AStationModule* Module);
+
+	/** BFS from the tiles in Queue, lowering neighbour distances until nothing improves */
+	void Relax(FField& Field);
+};
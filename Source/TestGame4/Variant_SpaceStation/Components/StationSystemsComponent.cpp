@@ -5,48 +5,189 @@
 #include "StationGrid.h"
 #include "SpaceStationGameMode.h"
 #include "Kismet/GameplayStatics.h"
+#include "TestGame4.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Systems Tick"), STAT_StationSystemsTick, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Recalculate Resources"), STAT_StationRecalculateResources, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Power Distribution"), STAT_StationPowerDistribution, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Atmosphere Propagation"), STAT_StationAtmosphere, STATGROUP_SpaceStation);
 
 UStationSystemsComponent::UStationSystemsComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false; // Ticked manually from GameMode
+
+	// Module types that serve crew needs
+	PathFields.TrackModuleType(EStationModuleType::LifeSupport);
+	PathFields.TrackModuleType(EStationModuleType::MessHall);
+	PathFields.TrackModuleType(EStationModuleType::Quarters);
+
+	AtmosphereGraph.OnAtmosphereChanged.BindUObject(this, &UStationSystemsComponent::RefreshUsability);
 }
 
 void UStationSystemsComponent::TickSystems(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationSystemsTick);
+
+	if (!bValidateIncrementalState)
+		return;
+
 	SystemUpdateTimer += DeltaSeconds;
 	if (SystemUpdateTimer >= SystemUpdateInterval)
 	{
 		SystemUpdateTimer = 0.0f;
-		RecalculateResources();
-		UpdatePowerDistribution();
-		PropagateAtmosphere();
+		ValidateIncrementalState();
+	}
+}
+
+void UStationSystemsComponent::OnModuleRegistered(AStationModule* Module)
+{
+	OnModulesRegistered(MakeArrayView(&Module, 1));
+}
+
+void UStationSystemsComponent::OnModulesRegistered(TConstArrayView<AStationModule*> Modules)
+{
+	TArray<AStationModule*, TInlineAllocator<16>> Added;
+	for (AStationModule* Module : Modules)
+	{
+		if (!Module || ModuleContributions.Contains(Module))
+			continue;
+
+		const FStationModuleContribution Contribution = MakeContribution(Module);
+		ModuleContributions.Add(Module, Contribution);
+		ApplyContribution(Contribution, 1);
+		PathFields.AddModuleTiles(Module);
+		Added.Add(Module);
+	}
+
+	if (Added.Num() == 0)
+		return;
+
+	// Sufficiency is judged on the final totals so a batch can't flip station power back and forth
+	RefreshSufficiency();
+
+	for (AStationModule* Module : Added)
+	{
+		ApplyPowerState(Module);
+
+		AtmosphereGraph.AddModule(Module, IsPoweredLifeSupport(Module));
+		RefreshUsability(Module);
 	}
 }
 
+void UStationSystemsComponent::OnModuleUnregistered(AStationModule* Module)
+{
+	FStationModuleContribution Contribution;
+	if (!Module || !ModuleContributions.RemoveAndCopyValue(Module, Contribution))
+		return;
+
+	AtmosphereGraph.RemoveModule(Module);
+	UsableModules.Remove(Module);
+	PathFields.RemoveModuleTiles(Module);
+
+	ApplyContribution(Contribution, -1);
+	RefreshSufficiency();
+}
+
+void UStationSystemsComponent::ResetSystems()
+{
+	ModuleContributions.Reset();
+	AtmosphereGraph.Reset();
+	UsableModules.Reset();
+	PathFields.Reset();
+
+	TotalPowerGeneration = 0;
+	TotalPowerConsumption = 0;
+	TotalOxygenGeneration = 0;
+	TotalOxygenConsumption = 0;
+	SystemUpdateTimer = 0.0f;
+
+	RefreshSufficiency();
+}
+
+void UStationSystemsComponent::OnModuleStatsChanged(AStationModule* Module)
+{
+	FStationModuleContribution* Contribution = Module ? ModuleContributions.Find(Module) : nullptr;
+	if (!Contribution)
+		return;
+
+	ApplyContribution(*Contribution, -1);
+	*Contribution = MakeContribution(Module);
+	ApplyContribution(*Contribution, 1);
+
+	RefreshSufficiency();
+	ApplyPowerState(Module);
+}
+
 void UStationSystemsComponent::RecalculateResources()
 {
-	int32 OldPowerGen = TotalPowerGeneration;
-	int32 OldPowerCon = TotalPowerConsumption;
-	int32 OldOxygenGen = TotalOxygenGeneration;
-	int32 OldOxygenCon = TotalOxygenConsumption;
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationRecalculateResources);
 
 	TotalPowerGeneration = 0;
 	TotalPowerConsumption = 0;
 	TotalOxygenGeneration = 0;
 	TotalOxygenConsumption = 0;
+	ModuleContributions.Reset();
 
-	TArray<AStationModule*> Modules = GetAllModules();
-	for (AStationModule* Module : Modules)
+	for (AStationModule* Module : GetAllModules())
 	{
 		if (!Module || !Module->bIsPlaced)
 			continue;
 
-		TotalPowerGeneration += Module->PowerGeneration;
-		TotalPowerConsumption += Module->PowerConsumption;
-		TotalOxygenGeneration += Module->OxygenGeneration;
-		TotalOxygenConsumption += Module->OxygenConsumption;
+		const FStationModuleContribution Contribution = MakeContribution(Module);
+		ModuleContributions.Add(Module, Contribution);
+		ApplyContribution(Contribution, 1);
+	}
+
+	RefreshSufficiency();
+}
+
+void UStationSystemsComponent::UpdatePowerDistribution()
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationPowerDistribution);
+
+	for (AStationModule* Module : GetAllModules())
+	{
+		ApplyPowerState(Module);
 	}
+}
+
+void UStationSystemsComponent::PropagateAtmosphere()
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationAtmosphere);
 
+	// Full rebuild of the component graph; normal module changes update it incrementally
+	AtmosphereGraph.Reset();
+
+	for (AStationModule* Module : GetAllModules())
+	{
+		if (Module && Module->bIsPlaced)
+		{
+			AtmosphereGraph.AddModule(Module, IsPoweredLifeSupport(Module));
+		}
+	}
+}
+
+FStationModuleContribution UStationSystemsComponent::MakeContribution(const AStationModule* Module)
+{
+	FStationModuleContribution Contribution;
+	Contribution.PowerGeneration = Module->PowerGeneration;
+	Contribution.PowerConsumption = Module->PowerConsumption;
+	Contribution.OxygenGeneration = Module->OxygenGeneration;
+	Contribution.OxygenConsumption = Module->OxygenConsumption;
+	return Contribution;
+}
+
+void UStationSystemsComponent::ApplyContribution(const FStationModuleContribution& Contribution, int32 Sign)
+{
+	TotalPowerGeneration += Sign * Contribution.PowerGeneration;
+	TotalPowerConsumption += Sign * Contribution.PowerConsumption;
+	TotalOxygenGeneration += Sign * Contribution.OxygenGeneration;
+	TotalOxygenConsumption += Sign * Contribution.OxygenConsumption;
+}
+
+void UStationSystemsComponent::RefreshSufficiency()
+{
 	bool bOldPowerState = bHasSufficientPower;
 	bool bOldOxygenState = bHasSufficientOxygen;
 
@@ -56,6 +197,9 @@ void UStationSystemsComponent::RecalculateResources()
 	// Fire events if state changed
 	if (bOldPowerState != bHasSufficientPower)
 	{
+		// Global pool: a flip changes every powered module, including life support
+		UpdatePowerDistribution();
+
 		OnPowerStateChanged.Broadcast();
 	}
 	if (bOldOxygenState != bHasSufficientOxygen)
@@ -64,103 +208,117 @@ void UStationSystemsComponent::RecalculateResources()
 	}
 }
 
-void UStationSystemsComponent::UpdatePowerDistribution()
+void UStationSystemsComponent::ApplyPowerState(AStationModule* Module)
 {
-	TArray<AStationModule*> Modules = GetAllModules();
+	if (!Module || !Module->bIsPlaced)
+		return;
 
-	for (AStationModule* Module : Modules)
+	// Modules that don't require power are always powered
+	// Otherwise, if station has sufficient power all modules are powered,
+	// if not, nothing is powered (simple global pool model)
+	bool bShouldBePowered = !Module->bRequiresPower || bHasSufficientPower;
+	if (Module->bIsPowered != bShouldBePowered)
 	{
-		if (!Module || !Module->bIsPlaced)
-			continue;
-
-		// Modules that don't require power are always powered
-		if (!Module->bRequiresPower)
-		{
-			if (!Module->bIsPowered)
-			{
-				Module->SetPoweredState(true);
-			}
-			continue;
-		}
-
-		// If station has sufficient power, all modules are powered
-		// If not, nothing is powered (simple global pool model)
-		bool bShouldBePowered = bHasSufficientPower;
-		if (Module->bIsPowered != bShouldBePowered)
-		{
-			Module->SetPoweredState(bShouldBePowered);
-		}
+		Module->SetPoweredState(bShouldBePowered);
+		RefreshUsability(Module);
 	}
+
+	// No-op unless this changed whether the module supplies atmosphere
+	AtmosphereGraph.SetAtmosphereSource(Module, IsPoweredLifeSupport(Module));
 }
 
-void UStationSystemsComponent::PropagateAtmosphere()
+AStationModule* UStationSystemsComponent::FindNearestUsableModule(EStationModuleType ModuleType, const FVector& Location) const
 {
-	TArray<AStationModule*> Modules = GetAllModules();
+	return UsableModules.FindNearest(ModuleType, Location);
+}
 
-	// First, clear all atmosphere flags
-	for (AStationModule* Module : Modules)
+AStationModule* UStationSystemsComponent::FindNearestReachableModule(EStationModuleType ModuleType, const FVector& Location) const
+{
+	AStationGrid* Grid = GetStationGrid();
+	if (Grid)
 	{
-		if (Module && Module->bIsPlaced)
+		const FIntPoint Tile = Grid->WorldToGrid(Location);
+		if (PathFields.IsWalkable(Tile))
 		{
-			Module->bHasAtmosphere = false;
+			return PathFields.FindNearest(ModuleType, Tile);
 		}
 	}
 
-	// Find all powered life support modules (OxygenGeneration > 0)
-	// and flood-fill atmosphere from them
-	TSet<AStationModule*> VisitedModules;
+	// Off the tile graph (e.g. just spawned outside the station), so straight-line distance is all there is
+	return UsableModules.FindNearest(ModuleType, Location);
+}
 
-	for (AStationModule* Module : Modules)
-	{
-		if (!Module || !Module->bIsPlaced)
-			continue;
+void UStationSystemsComponent::RefreshUsability(AStationModule* Module)
+{
+	// Only registered modules are indexed, so unregistering can never leave one behind
+	const bool bUsable = Module && ModuleContributions.Contains(Module)
+		&& Module->bIsPlaced && Module->bIsPowered && Module->bHasAtmosphere;
+	const bool bWasUsable = UsableModules.Contains(Module);
+	if (bUsable == bWasUsable)
+		return;
 
-		// Life support: generates oxygen and is currently powered
-		if (Module->OxygenGeneration > 0 && Module->bIsPowered)
-		{
-			FloodFillAtmosphere(Module, VisitedModules);
-		}
-	}
+	UsableModules.Update(Module, bUsable);
+	PathFields.SetSource(Module, bUsable);
 }
 
-void UStationSystemsComponent::FloodFillAtmosphere(AStationModule* StartModule, TSet<AStationModule*>& VisitedModules)
+bool UStationSystemsComponent::IsPoweredLifeSupport(const AStationModule* Module)
 {
-	if (!StartModule || VisitedModules.Contains(StartModule))
-		return;
+	return Module->OxygenGeneration > 0 && Module->bIsPowered;
+}
+
+void UStationSystemsComponent::ValidateIncrementalState()
+{
+	const int32 RunningPowerGen = TotalPowerGeneration;
+	const int32 RunningPowerCon = TotalPowerConsumption;
+	const int32 RunningOxygenGen = TotalOxygenGeneration;
+	const int32 RunningOxygenCon = TotalOxygenConsumption;
+
+	// Full rebuild, exactly what used to run every interval
+	RecalculateResources();
+	UpdatePowerDistribution();
+
+	if (RunningPowerGen != TotalPowerGeneration || RunningPowerCon != TotalPowerConsumption
+		|| RunningOxygenGen != TotalOxygenGeneration || RunningOxygenCon != TotalOxygenConsumption)
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Station totals drifted: power %d/%d (expected %d/%d), oxygen %d/%d (expected %d/%d). Was a module stat changed without OnModuleStatsChanged?"),
+			RunningPowerGen, RunningPowerCon, TotalPowerGeneration, TotalPowerConsumption,
+			RunningOxygenGen, RunningOxygenCon, TotalOxygenGeneration, TotalOxygenConsumption);
+	}
 
-	// Use a queue for BFS flood fill
-	TQueue<AStationModule*> Queue;
-	Queue.Enqueue(StartModule);
-	VisitedModules.Add(StartModule);
+	const TConstArrayView<AStationModule*> Modules = GetAllModules();
 
-	while (!Queue.IsEmpty())
+	TBitArray<> HadAtmosphere;
+	HadAtmosphere.Reserve(Modules.Num());
+	for (const AStationModule* Module : Modules)
 	{
-		AStationModule* Current;
-		Queue.Dequeue(Current);
+		HadAtmosphere.Add(Module && Module->bHasAtmosphere);
+	}
 
-		// Set atmosphere on this module
-		Current->bHasAtmosphere = true;
+	PropagateAtmosphere();
 
-		// Spread to connected modules
-		for (AStationModule* Connected : Current->ConnectedModules)
+	int32 NumMismatched = 0;
+	for (int32 Index = 0; Index < Modules.Num(); ++Index)
+	{
+		if (Modules[Index] && Modules[Index]->bHasAtmosphere != HadAtmosphere[Index])
 		{
-			if (Connected && Connected->bIsPlaced && !VisitedModules.Contains(Connected))
-			{
-				VisitedModules.Add(Connected);
-				Queue.Enqueue(Connected);
-			}
+			++NumMismatched;
 		}
 	}
+
+	if (NumMismatched > 0)
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Station atmosphere drifted on %d modules."), NumMismatched);
+	}
 }
 
-TArray<AStationModule*> UStationSystemsComponent::GetAllModules() const
+TConstArrayView<AStationModule*> UStationSystemsComponent::GetAllModules() const
 {
 	ASpaceStationGameMode* GM = Cast<ASpaceStationGameMode>(GetOwner());
 	if (GM)
 	{
 		return GM->GetAllModules();
 	}
-	return TArray<AStationModule*>();
+	return TConstArrayView<AStationModule*>();
 }
 
 AStationGrid* UStationSystemsComponent::GetStationGrid() const
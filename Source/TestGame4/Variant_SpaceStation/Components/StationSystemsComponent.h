@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "StationAtmosphereGraph.h"
+#include "StationModuleSpatialIndex.h"
+#include "StationPathDistanceFields.h"
 #include "StationSystemsComponent.generated.h"
 
 class AStationModule;
@@ -11,10 +14,23 @@ class AStationGrid;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSystemStateChanged);
 
+/** What one module currently adds to the station totals, kept so it can be subtracted exactly later */
+struct FStationModuleContribution
+{
+	int32 PowerGeneration = 0;
+	int32 PowerConsumption = 0;
+	int32 OxygenGeneration = 0;
+	int32 OxygenConsumption = 0;
+};
+
 /**
  * Station-wide system simulation component.
  * Manages power distribution, oxygen/atmosphere propagation, and resource tracking.
  * Attached to the GameMode actor.
+ *
+ * Totals are running sums updated in O(1) when a module is registered, unregistered or changes its
+ * stats. Power and atmosphere are only pushed to the modules a change affects; the full passes remain
+ * available for explicit rebuilds and as an optional debug validation.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class UStationSystemsComponent : public UActorComponent
@@ -58,6 +74,21 @@ public:
 	/** Tick station systems (called from GameMode::Tick) */
 	void TickSystems(float DeltaSeconds);
 
+	/** Adds a newly registered module to the running totals and gives it the current power and atmosphere state */
+	void OnModuleRegistered(AStationModule* Module);
+
+	/** Batch form of OnModuleRegistered; station power is re-evaluated once for the whole batch */
+	void OnModulesRegistered(TConstArrayView<AStationModule*> Modules);
+
+	/** Removes an unregistered module from the running totals */
+	void OnModuleUnregistered(AStationModule* Module);
+
+	/** Forgets every module and zeroes the totals, before a whole station is replaced */
+	void ResetSystems();
+
+	/** Re-reads a registered module's power and oxygen stats after they were changed at runtime */
+	void OnModuleStatsChanged(AStationModule* Module);
+
 	/** Recalculate all resource totals from module registry */
 	UFUNCTION(BlueprintCallable, Category="Systems")
 	void RecalculateResources();
@@ -66,7 +97,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Systems")
 	void UpdatePowerDistribution();
 
-	/** Propagate atmosphere through connected modules from life support */
+	/** Rebuild atmosphere regions from scratch (module changes update them incrementally) */
 	UFUNCTION(BlueprintCallable, Category="Systems")
 	void PropagateAtmosphere();
 
@@ -82,6 +113,18 @@ public:
 	UFUNCTION(BlueprintPure, Category="Systems")
 	int32 GetNetPower() const { return TotalPowerGeneration - TotalPowerConsumption; }
 
+	/** Connected module regions, for queries such as whether two modules share air */
+	const FStationAtmosphereGraph& GetAtmosphereGraph() const { return AtmosphereGraph; }
+
+	/** Nearest module of a type that crew can use right now (placed, powered, with atmosphere) */
+	AStationModule* FindNearestUsableModule(EStationModuleType ModuleType, const FVector& Location) const;
+
+	/**
+	 * Usable module of a type with the shortest walk from Location through the station's tiles.
+	 * Falls back to FindNearestUsableModule when Location is not on a station tile.
+	 */
+	AStationModule* FindNearestReachableModule(EStationModuleType ModuleType, const FVector& Location) const;
+
 	/** Get net oxygen (generation - consumption) */
 	UFUNCTION(BlueprintPure, Category="Systems")
 	int32 GetNetOxygen() const { return TotalOxygenGeneration - TotalOxygenConsumption; }
@@ -98,19 +141,53 @@ public:
 
 private:
 
-	/** Timer for periodic system updates */
+	/** Timer for periodic validation passes */
 	float SystemUpdateTimer = 0.0f;
 
-	/** How often to recalculate systems (seconds) */
+	/** How often to validate the running totals when validation is enabled (seconds) */
 	UPROPERTY(EditAnywhere, Category="Systems")
 	float SystemUpdateInterval = 0.5f;
 
-	/** Helper: Get all modules from GameMode */
-	TArray<AStationModule*> GetAllModules() const;
+	/** Periodically recompute everything from scratch and log any drift from the incremental state */
+	UPROPERTY(EditAnywhere, Category="Systems|Debug")
+	bool bValidateIncrementalState = false;
+
+	/** Contribution currently accounted for each registered module */
+	TMap<const AStationModule*, FStationModuleContribution> ModuleContributions;
+
+	/** Connected module regions and which of them contain powered life support */
+	FStationAtmosphereGraph AtmosphereGraph;
+
+	/** Usable modules bucketed by type and position, kept in sync with power and atmosphere changes */
+	FStationModuleSpatialIndex UsableModules;
+
+	/** Walking distance from every tile to the nearest usable module of each type crew needs */
+	FStationPathDistanceFields PathFields;
+
+	/** Add or remove a module from UsableModules after its power or atmosphere changed */
+	void RefreshUsability(AStationModule* Module);
+
+	/** Helper: Snapshot a module's current stats */
+	static FStationModuleContribution MakeContribution(const AStationModule* Module);
+
+	/** Helper: Add (Sign = 1) or subtract (Sign = -1) a contribution from the running totals */
+	void ApplyContribution(const FStationModuleContribution& Contribution, int32 Sign);
+
+	/** Re-derive the sufficiency flags; pushes power to every module and fires events only when they flip */
+	void RefreshSufficiency();
+
+	/** Set a single module's powered state from the current station power */
+	void ApplyPowerState(AStationModule* Module);
+
+	/** Helper: Does this module currently generate atmosphere */
+	static bool IsPoweredLifeSupport(const AStationModule* Module);
+
+	/** Compare the running state against a full recompute and resync on mismatch */
+	void ValidateIncrementalState();
+
+	/** Helper: View of all modules registered with the GameMode (no copy) */
+	TConstArrayView<AStationModule*> GetAllModules() const;
 
 	/** Helper: Get station grid from GameMode */
 	AStationGrid* GetStationGrid() const;
-
-	/** Flood-fill atmosphere from a starting module */
-	void FloodFillAtmosphere(AStationModule* StartModule, TSet<AStationModule*>& VisitedModules);
 };
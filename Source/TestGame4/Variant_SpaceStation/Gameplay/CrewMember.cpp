@@ -8,6 +8,9 @@
 #include "AIController.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crew Member Tick"), STAT_StationCrewMemberTick, STATGROUP_SpaceStation);
 
 ACrewMember::ACrewMember()
 {
@@ -74,14 +77,13 @@ void ACrewMember::GenerateRandomName()
 
 void ACrewMember::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewMemberTick);
+
 	Super::Tick(DeltaSeconds);
 
 	if (!IsAlive())
 		return;
 
-	UpdateCurrentModule();
-	UpdateAtmosphereState();
-
 	// Check if we've arrived at target
 	if (TargetModule && HasArrivedAtTarget() && !bIsInteracting)
 	{
@@ -175,20 +177,25 @@ bool ACrewMember::IsAlive() const
 	return NeedsComponent && NeedsComponent->bIsAlive;
 }
 
-void ACrewMember::UpdateCurrentModule()
+void ACrewMember::UpdateModuleState(const AStationGrid* Grid)
 {
-	ASpaceStationGameMode* GM = GetWorld()->GetAuthGameMode<ASpaceStationGameMode>();
-	if (!GM)
-		return;
+	UpdateCurrentModule(Grid);
+	UpdateAtmosphereState();
+}
 
-	AStationGrid* Grid = GM->GetStationGrid();
+void ACrewMember::UpdateCurrentModule(const AStationGrid* Grid)
+{
 	if (!Grid)
 		return;
 
-	// Find which module we're standing in
-	FIntPoint GridCoord = Grid->WorldToGrid(GetActorLocation());
-	AStationModule* ModuleAtPos = Grid->GetModuleAt(GridCoord);
-	CurrentModule = ModuleAtPos;
+	// Only look the module up again when we step onto another tile or the grid changed under us
+	const FIntPoint GridCoord = Grid->WorldToGrid(GetActorLocation());
+	if (GridCoord == CachedTile && Grid->GetRevision() == CachedGridRevision)
+		return;
+
+	CachedTile = GridCoord;
+	CachedGridRevision = Grid->GetRevision();
+	CurrentModule = Grid->GetModuleAt(GridCoord);
 }
 
 void ACrewMember::UpdateAtmosphereState()
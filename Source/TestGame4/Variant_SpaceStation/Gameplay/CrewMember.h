@@ -8,6 +8,7 @@
 #include "CrewMember.generated.h"
 
 class AStationModule;
+class AStationGrid;
 class UCrewNeedsComponent;
 
 /**
@@ -136,6 +137,9 @@ public:
 	UFUNCTION(BlueprintPure, Category="Needs")
 	bool IsAlive() const;
 
+	/** Update current module and atmosphere from position (called in batch by the crew simulation) */
+	void UpdateModuleState(const AStationGrid* Grid);
+
 	// Blueprint Events
 
 	/** Called when crew member is selected/deselected */
@@ -157,7 +161,7 @@ public:
 private:
 
 	/** Update current module based on position */
-	void UpdateCurrentModule();
+	void UpdateCurrentModule(const AStationGrid* Grid);
 
 	/** Update atmosphere state from current module */
 	void UpdateAtmosphereState();
@@ -167,4 +171,8 @@ private:
 
 	/** Arrival distance threshold */
 	float ArrivalDistance = 100.0f;
+
+	/** Tile CurrentModule was looked up for, and the grid revision it was valid at (0 = never looked up) */
+	FIntPoint CachedTile = FIntPoint::ZeroValue;
+	uint32 CachedGridRevision = 0;
 };
@@ -0,0 +1,321 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CrewSimulationSubsystem.h"
+#include "CrewNeedsComponent.h"
+#include "CrewMember.h"
+#include "SpaceStationGameMode.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crew Simulation"), STAT_StationCrewSimulation, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Crew Simulation Gather"), STAT_StationCrewSimulationGather, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Crew Simulation Pass"), STAT_StationCrewSimulationPass, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Crew Simulation Dispatch"), STAT_StationCrewSimulationDispatch, STATGROUP_SpaceStation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crew Simulated"), STAT_StationCrewSimulated, STATGROUP_SpaceStation);
+DECLARE_MEMORY_STAT(TEXT("Crew Needs Buffers"), STAT_StationCrewNeedsMemory, STATGROUP_SpaceStation);
+
+namespace
+{
+	constexpr uint8 OxygenCriticalBit = 1 << 0;
+	constexpr uint8 FoodCriticalBit = 1 << 1;
+	constexpr uint8 SleepCriticalBit = 1 << 2;
+	constexpr uint8 DiedBit = 1 << 3;
+}
+
+void FCrewNeedsBuffer::Add()
+{
+	Oxygen.Add(100.0f);
+	Food.Add(100.0f);
+	Sleep.Add(100.0f);
+	Health.Add(100.0f);
+	Rates.AddDefaulted();
+	Alive.Add(1);
+	InAtmosphere.Add(0);
+	CriticalFlags.Add(0);
+	Events.Add(0);
+}
+
+void FCrewNeedsBuffer::RemoveAtSwap(int32 Index)
+{
+	Oxygen.RemoveAtSwap(Index, EAllowShrinking::No);
+	Food.RemoveAtSwap(Index, EAllowShrinking::No);
+	Sleep.RemoveAtSwap(Index, EAllowShrinking::No);
+	Health.RemoveAtSwap(Index, EAllowShrinking::No);
+	Rates.RemoveAtSwap(Index, EAllowShrinking::No);
+	Alive.RemoveAtSwap(Index, EAllowShrinking::No);
+	InAtmosphere.RemoveAtSwap(Index, EAllowShrinking::No);
+	CriticalFlags.RemoveAtSwap(Index, EAllowShrinking::No);
+	Events.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void FCrewNeedsBuffer::Reset()
+{
+	Oxygen.Reset();
+	Food.Reset();
+	Sleep.Reset();
+	Health.Reset();
+	Rates.Reset();
+	Alive.Reset();
+	InAtmosphere.Reset();
+	CriticalFlags.Reset();
+	Events.Reset();
+}
+
+SIZE_T FCrewNeedsBuffer::GetAllocatedSize() const
+{
+	return Oxygen.GetAllocatedSize() + Food.GetAllocatedSize() + Sleep.GetAllocatedSize() + Health.GetAllocatedSize()
+		+ Rates.GetAllocatedSize() + Alive.GetAllocatedSize() + InAtmosphere.GetAllocatedSize()
+		+ CriticalFlags.GetAllocatedSize() + Events.GetAllocatedSize();
+}
+
+TStatId UCrewSimulationSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_StationCrewSimulation);
+}
+
+void UCrewSimulationSubsystem::Deinitialize()
+{
+	for (UCrewNeedsComponent* Component : Components)
+	{
+		if (Component)
+		{
+			Component->SimulationIndex = INDEX_NONE;
+		}
+	}
+
+	Components.Reset();
+	Needs.Reset();
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_StationCrewNeedsMemory, ReportedMemory, 0);
+
+	Super::Deinitialize();
+}
+
+void UCrewSimulationSubsystem::RegisterCrew(UCrewNeedsComponent* Component)
+{
+	if (!Component || Component->SimulationIndex != INDEX_NONE)
+		return;
+
+	const int32 Index = Components.Add(Component);
+	Needs.Add();
+	Component->SimulationIndex = Index;
+	CopyToSlot(Component, Index);
+	ReportMemory();
+}
+
+void UCrewSimulationSubsystem::UnregisterCrew(UCrewNeedsComponent* Component)
+{
+	if (!Component || !Components.IsValidIndex(Component->SimulationIndex) || Components[Component->SimulationIndex] != Component)
+		return;
+
+	// Swap-remove and patch the index of whichever crew member moved into the gap
+	const int32 Index = Component->SimulationIndex;
+	Components.RemoveAtSwap(Index, EAllowShrinking::No);
+	Needs.RemoveAtSwap(Index);
+	if (Components.IsValidIndex(Index))
+	{
+		Components[Index]->SimulationIndex = Index;
+	}
+
+	Component->SimulationIndex = INDEX_NONE;
+}
+
+void UCrewSimulationSubsystem::PushNeeds(const UCrewNeedsComponent* Component)
+{
+	if (Component && Components.IsValidIndex(Component->SimulationIndex))
+	{
+		CopyToSlot(Component, Component->SimulationIndex);
+	}
+}
+
+void UCrewSimulationSubsystem::CopyToSlot(const UCrewNeedsComponent* Component, int32 Index)
+{
+	Needs.Oxygen[Index] = Component->Oxygen;
+	Needs.Food[Index] = Component->Food;
+	Needs.Sleep[Index] = Component->Sleep;
+	Needs.Health[Index] = Component->Health;
+	Needs.Alive[Index] = Component->bIsAlive ? 1 : 0;
+	Needs.InAtmosphere[Index] = Component->bInAtmosphere ? 1 : 0;
+
+	FCrewNeedRates& Rates = Needs.Rates[Index];
+	Rates.OxygenDepletion = Component->OxygenDepletionRate;
+	Rates.FoodDepletion = Component->FoodDepletionRate;
+	Rates.SleepDepletion = Component->SleepDepletionRate;
+	Rates.HealthRegen = Component->HealthRegenRate;
+	Rates.HealthDepletionFromOxygen = Component->HealthDepletionFromOxygen;
+	Rates.HealthDepletionFromFood = Component->HealthDepletionFromFood;
+	Rates.CriticalThreshold = Component->CriticalThreshold;
+}
+
+void UCrewSimulationSubsystem::Tick(float DeltaTime)
+{
+	const int32 Count = Needs.Num();
+	if (Count == 0)
+		return;
+
+	GatherAtmosphere();
+
+	bool bHasEvents = false;
+	{
+		TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewSimulationPass);
+		INC_DWORD_STAT_BY(STAT_StationCrewSimulated, Count);
+
+		const int32 NumChunks = FMath::DivideAndRoundUp(Count, ParallelBatchSize);
+		ChunkHasEvents.SetNum(NumChunks, EAllowShrinking::No);
+
+		ParallelFor(NumChunks, [this, Count, DeltaTime](int32 ChunkIndex)
+		{
+			const int32 BeginIndex = ChunkIndex * ParallelBatchSize;
+			ChunkHasEvents[ChunkIndex] = SimulateRange(BeginIndex, FMath::Min(BeginIndex + ParallelBatchSize, Count), DeltaTime) ? 1 : 0;
+		}, NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		bHasEvents = ChunkHasEvents.Contains(1);
+	}
+
+	ScatterAndDispatch(bHasEvents);
+}
+
+void UCrewSimulationSubsystem::GatherAtmosphere()
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewSimulationGather);
+
+	ASpaceStationGameMode* GM = GetWorld()->GetAuthGameMode<ASpaceStationGameMode>();
+	const AStationGrid* Grid = GM ? GM->GetStationGrid() : nullptr;
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (!Needs.Alive[Index])
+			continue;
+
+		UCrewNeedsComponent* Component = Components[Index];
+		if (ACrewMember* Crew = Cast<ACrewMember>(Component->GetOwner()))
+		{
+			Crew->UpdateModuleState(Grid);
+		}
+
+		// Read back rather than assume, so SetInAtmosphere from Blueprint still applies
+		Needs.InAtmosphere[Index] = Component->bInAtmosphere ? 1 : 0;
+	}
+}
+
+bool UCrewSimulationSubsystem::SimulateRange(int32 BeginIndex, int32 EndIndex, float DeltaTime)
+{
+	float* RESTRICT Oxygen = Needs.Oxygen.GetData();
+	float* RESTRICT Food = Needs.Food.GetData();
+	float* RESTRICT Sleep = Needs.Sleep.GetData();
+	float* RESTRICT Health = Needs.Health.GetData();
+	const FCrewNeedRates* RESTRICT Rates = Needs.Rates.GetData();
+	uint8* RESTRICT Alive = Needs.Alive.GetData();
+	const uint8* RESTRICT InAtmosphere = Needs.InAtmosphere.GetData();
+	uint8* RESTRICT CriticalFlags = Needs.CriticalFlags.GetData();
+	uint8* RESTRICT Events = Needs.Events.GetData();
+
+	bool bAnyEvents = false;
+
+	for (int32 i = BeginIndex; i < EndIndex; ++i)
+	{
+		if (!Alive[i])
+		{
+			Events[i] = 0;
+			continue;
+		}
+
+		const FCrewNeedRates& Rate = Rates[i];
+
+		// Oxygen still depletes slowly in atmosphere (need life support to fully sustain)
+		const float OxygenRate = InAtmosphere[i] ? Rate.OxygenDepletion * 0.25f : Rate.OxygenDepletion;
+		Oxygen[i] = FMath::Max(0.0f, Oxygen[i] - OxygenRate * DeltaTime);
+		Food[i] = FMath::Max(0.0f, Food[i] - Rate.FoodDepletion * DeltaTime);
+		Sleep[i] = FMath::Max(0.0f, Sleep[i] - Rate.SleepDepletion * DeltaTime);
+
+		const uint8 Critical = (Oxygen[i] < Rate.CriticalThreshold ? OxygenCriticalBit : 0)
+			| (Food[i] < Rate.CriticalThreshold ? FoodCriticalBit : 0)
+			| (Sleep[i] < Rate.CriticalThreshold ? SleepCriticalBit : 0);
+		uint8 Raised = Critical & ~CriticalFlags[i];
+		CriticalFlags[i] = Critical;
+
+		// Health depletes when critical needs aren't met and regenerates when none are critical
+		float NewHealth = Health[i];
+		if (Critical & OxygenCriticalBit)
+		{
+			NewHealth = FMath::Max(0.0f, NewHealth - Rate.HealthDepletionFromOxygen * DeltaTime);
+		}
+		if (Critical & FoodCriticalBit)
+		{
+			NewHealth = FMath::Max(0.0f, NewHealth - Rate.HealthDepletionFromFood * DeltaTime);
+		}
+		if (Critical == 0 && NewHealth < 100.0f)
+		{
+			NewHealth = FMath::Min(100.0f, NewHealth + Rate.HealthRegen * DeltaTime);
+		}
+		Health[i] = NewHealth;
+
+		if (NewHealth <= 0.0f)
+		{
+			Alive[i] = 0;
+			Raised |= DiedBit;
+		}
+
+		Events[i] = Raised;
+		bAnyEvents |= Raised != 0;
+	}
+
+	return bAnyEvents;
+}
+
+void UCrewSimulationSubsystem::ScatterAndDispatch(bool bHasEvents)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationCrewSimulationDispatch);
+
+	struct FPendingEvent
+	{
+		UCrewNeedsComponent* Component;
+		uint8 Events;
+	};
+	TArray<FPendingEvent, TInlineAllocator<16>> PendingEvents;
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (!Needs.Alive[Index] && !Needs.Events[Index])
+			continue;
+
+		UCrewNeedsComponent* Component = Components[Index];
+		Component->Oxygen = Needs.Oxygen[Index];
+		Component->Food = Needs.Food[Index];
+		Component->Sleep = Needs.Sleep[Index];
+		Component->Health = Needs.Health[Index];
+		Component->bIsAlive = Needs.Alive[Index] != 0;
+
+		if (bHasEvents && Needs.Events[Index])
+		{
+			PendingEvents.Add({ Component, Needs.Events[Index] });
+		}
+	}
+
+	// Fired after the scatter because Blueprint handlers may unregister crew and reorder the arrays
+	for (const FPendingEvent& Pending : PendingEvents)
+	{
+		if (Pending.Events & OxygenCriticalBit)
+		{
+			Pending.Component->BP_NeedCritical(ECrewNeedType::Oxygen);
+		}
+		if (Pending.Events & FoodCriticalBit)
+		{
+			Pending.Component->BP_NeedCritical(ECrewNeedType::Food);
+		}
+		if (Pending.Events & SleepCriticalBit)
+		{
+			Pending.Component->BP_NeedCritical(ECrewNeedType::Sleep);
+		}
+		if (Pending.Events & DiedBit)
+		{
+			Pending.Component->BP_CrewDied();
+		}
+	}
+}
+
+void UCrewSimulationSubsystem::ReportMemory()
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_StationCrewNeedsMemory, ReportedMemory,
+		Components.GetAllocatedSize() + Needs.GetAllocatedSize() + ChunkHasEvents.GetAllocatedSize());
+}
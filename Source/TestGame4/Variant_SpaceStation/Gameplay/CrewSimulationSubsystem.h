@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CrewSimulationSubsystem.generated.h"
+
+class UCrewNeedsComponent;
+
+/** Per-crew tuning copied from the needs component on registration */
+struct FCrewNeedRates
+{
+	float OxygenDepletion = 0.0f;
+	float FoodDepletion = 0.0f;
+	float SleepDepletion = 0.0f;
+	float HealthRegen = 0.0f;
+	float HealthDepletionFromOxygen = 0.0f;
+	float HealthDepletionFromFood = 0.0f;
+	float CriticalThreshold = 0.0f;
+};
+
+/**
+ * Structure-of-arrays needs state for every registered crew member.
+ * Element i always belongs to the component at index i of the subsystem's component list.
+ */
+struct FCrewNeedsBuffer
+{
+	TArray<float> Oxygen;
+	TArray<float> Food;
+	TArray<float> Sleep;
+	TArray<float> Health;
+	TArray<FCrewNeedRates> Rates;
+
+	/** 1 if alive; bytes rather than bools so the pass can read them without masking */
+	TArray<uint8> Alive;
+	TArray<uint8> InAtmosphere;
+
+	/** One bit per need (oxygen, food, sleep) that was critical after the last pass */
+	TArray<uint8> CriticalFlags;
+
+	/** Needs that became critical in the last pass plus a death bit, dispatched to Blueprint afterwards */
+	TArray<uint8> Events;
+
+	int32 Num() const { return Oxygen.Num(); }
+	void Add();
+	void RemoveAtSwap(int32 Index);
+	void Reset();
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Batched crew needs simulation.
+ * Replaces one ticking needs component per crew member with a single pass over contiguous arrays
+ * (in parallel for large crews). The pass only records threshold crossings; BP_NeedCritical and BP_CrewDied
+ * are dispatched afterwards on the game thread, and only for the crew that crossed one.
+ * Need values are mirrored back to each component after the pass so Blueprint and UI reads stay valid.
+ */
+UCLASS()
+class UCrewSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void RegisterCrew(UCrewNeedsComponent* Component);
+	void UnregisterCrew(UCrewNeedsComponent* Component);
+
+	/** Copy a component's need values and rates into its slot after they were changed outside the pass */
+	void PushNeeds(const UCrewNeedsComponent* Component);
+
+	int32 GetNumCrew() const { return Components.Num(); }
+
+	/** Crews at least this large are processed with ParallelFor, in chunks of this many crew members */
+	static constexpr int32 ParallelBatchSize = 256;
+
+private:
+
+	UPROPERTY()
+	TArray<TObjectPtr<UCrewNeedsComponent>> Components;
+
+	FCrewNeedsBuffer Needs;
+
+	/** Scratch per-chunk flags so dispatch can be skipped when nothing crossed a threshold */
+	TArray<uint8> ChunkHasEvents;
+
+	/** Bytes of the arrays above last reported to the crew needs memory stat */
+	SIZE_T ReportedMemory = 0;
+
+	/** Refresh atmosphere and current module for every living crew member */
+	void GatherAtmosphere();
+
+	/** Deplete needs and update health for [BeginIndex, EndIndex); returns true if any crew raised an event */
+	bool SimulateRange(int32 BeginIndex, int32 EndIndex, float DeltaTime);
+
+	/** Copy results back to the components and fire any recorded events */
+	void ScatterAndDispatch(bool bHasEvents);
+
+	void CopyToSlot(const UCrewNeedsComponent* Component, int32 Index);
+	void ReportMemory();
+};
@@ -6,8 +6,19 @@
 #include "StationSystemsComponent.h"
 #include "StationNotificationSystem.h"
 #include "CrewMember.h"
+#include "StationSaveFormat.h"
+#include "SpaceStationPlayerController.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include "UObject/SoftObjectPath.h"
+#include "TestGame4.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Game Mode Tick"), STAT_StationGameModeTick, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Recalculate Systems"), STAT_StationRecalculateSystems, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Save Station"), STAT_StationSave, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Load Station"), STAT_StationLoad, STATGROUP_SpaceStation);
 
 ASpaceStationGameMode::ASpaceStationGameMode()
 {
@@ -36,6 +47,8 @@ void ASpaceStationGameMode::BeginPlay()
 
 void ASpaceStationGameMode::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationGameModeTick);
+
 	Super::Tick(DeltaSeconds);
 
 	// Tick station systems
@@ -56,10 +69,12 @@ void ASpaceStationGameMode::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 void ASpaceStationGameMode::RegisterModule(AStationModule* Module)
 {
-	if (Module && !AllModules.Contains(Module))
+	if (ModuleRegistry.Add(Module))
 	{
-		AllModules.Add(Module);
-		RecalculateSystems();
+		if (StationSystemsComponent)
+		{
+			StationSystemsComponent->OnModuleRegistered(Module);
+		}
 
 		if (NotificationSystem)
 		{
@@ -70,12 +85,43 @@ void ASpaceStationGameMode::RegisterModule(AStationModule* Module)
 	}
 }
 
+void ASpaceStationGameMode::RegisterModules(const TArray<AStationModule*>& Modules)
+{
+	TArray<AStationModule*> Added;
+	Added.Reserve(Modules.Num());
+	for (AStationModule* Module : Modules)
+	{
+		if (Module && ModuleRegistry.Add(Module))
+		{
+			Added.Add(Module);
+		}
+	}
+
+	if (Added.Num() == 0)
+		return;
+
+	if (StationSystemsComponent)
+	{
+		StationSystemsComponent->OnModulesRegistered(Added);
+	}
+
+	if (NotificationSystem)
+	{
+		const FString Message = Added.Num() == 1
+			? FString::Printf(TEXT("%s placed"), *Added[0]->ModuleName.ToString())
+			: FString::Printf(TEXT("%d modules placed"), Added.Num());
+		NotificationSystem->AddNotification(FText::FromString(Message), ENotificationPriority::Info, 3.0f);
+	}
+}
+
 void ASpaceStationGameMode::UnregisterModule(AStationModule* Module)
 {
-	if (Module)
+	if (ModuleRegistry.Remove(Module))
 	{
-		AllModules.Remove(Module);
-		RecalculateSystems();
+		if (StationSystemsComponent)
+		{
+			StationSystemsComponent->OnModuleUnregistered(Module);
+		}
 	}
 }
 
@@ -85,7 +131,7 @@ void ASpaceStationGameMode::RegisterCrew(ACrewMember* Crew)
 	{
 		AllCrew.Add(Crew);
 
-		if (NotificationSystem)
+		if (NotificationSystem && !bRestoringStation)
 		{
 			NotificationSystem->AddNotification(
 				FText::FromString(FString::Printf(TEXT("%s joined the crew"), *Crew->CrewName.ToString())),
@@ -122,12 +168,15 @@ ACrewMember* ASpaceStationGameMode::SpawnCrewMember(const FVector& SpawnLocation
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
+	INC_DWORD_STAT(STAT_StationActorsSpawned);
 	ACrewMember* NewCrew = GetWorld()->SpawnActor<ACrewMember>(ClassToSpawn, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
 	return NewCrew; // RegisterCrew is called from CrewMember::BeginPlay
 }
 
 void ASpaceStationGameMode::RecalculateSystems()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationRecalculateSystems);
+
 	if (StationSystemsComponent)
 	{
 		StationSystemsComponent->RecalculateResources();
@@ -145,12 +194,246 @@ void ASpaceStationGameMode::CreateStationGrid()
 	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = this;
+		INC_DWORD_STAT(STAT_StationActorsSpawned);
 		StationGrid = GetWorld()->SpawnActor<AStationGrid>(StationGridClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 	}
 	else
 	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = this;
+		INC_DWORD_STAT(STAT_StationActorsSpawned);
 		StationGrid = GetWorld()->SpawnActor<AStationGrid>(AStationGrid::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 	}
 }
+
+bool ASpaceStationGameMode::SaveStation(const FString& SaveName)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationSave);
+
+	const TArray<AStationModule*>& Modules = ModuleRegistry.GetAll();
+
+	TMap<UClass*, uint16> ClassIds;
+	TArray<FString> ClassPaths;
+	TArray<uint16> ModuleClasses;
+	TArray<FIntPoint> ModulePositions;
+	TArray<uint8> ModuleRotations;
+	ModuleClasses.Reserve(Modules.Num());
+	ModulePositions.Reserve(Modules.Num());
+	ModuleRotations.Reserve(Modules.Num());
+
+	for (const AStationModule* Module : Modules)
+	{
+		if (!Module)
+			continue;
+
+		UClass* ModuleClass = Module->GetClass();
+		const uint16* ClassId = ClassIds.Find(ModuleClass);
+		if (!ClassId)
+		{
+			if (ClassPaths.Num() > MAX_uint16)
+				return false;
+
+			ClassId = &ClassIds.Add(ModuleClass, static_cast<uint16>(ClassPaths.Num()));
+			ClassPaths.Add(FSoftClassPath(ModuleClass).ToString());
+		}
+
+		ModuleClasses.Add(*ClassId);
+		ModulePositions.Add(Module->GridPosition);
+		ModuleRotations.Add(static_cast<uint8>(FMath::RoundToInt(Module->GridRotation.Yaw / 90.0f) & 3));
+	}
+
+	TArray<FVector3f> CrewLocations;
+	TArray<FVector4f> CrewNeeds;
+	TArray<uint8> CrewAlive;
+	CrewLocations.Reserve(AllCrew.Num());
+	CrewNeeds.Reserve(AllCrew.Num());
+	CrewAlive.Reserve(AllCrew.Num());
+
+	for (const ACrewMember* Crew : AllCrew)
+	{
+		if (!Crew)
+			continue;
+
+		const UCrewNeedsComponent* Needs = Crew->GetNeedsComponent();
+		CrewLocations.Add(FVector3f(Crew->GetActorLocation()));
+		CrewNeeds.Add(Needs ? FVector4f(Needs->Oxygen, Needs->Food, Needs->Sleep, Needs->Health) : FVector4f(100.0f, 100.0f, 100.0f, 100.0f));
+		CrewAlive.Add(!Needs || Needs->bIsAlive ? 1 : 0);
+	}
+
+	FStationSaveView Save;
+	Save.Credits = CurrentCredits;
+	Save.Food = CurrentFood;
+	Save.ClassPaths = MoveTemp(ClassPaths);
+	Save.ModuleClasses = ModuleClasses;
+	Save.ModulePositions = ModulePositions;
+	Save.ModuleRotations = ModuleRotations;
+	Save.CrewLocations = CrewLocations;
+	Save.CrewNeeds = CrewNeeds;
+	Save.CrewAlive = CrewAlive;
+
+	if (!WriteStationSaveFile(GetStationSavePath(SaveName), Save))
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Failed to save station '%s'."), *SaveName);
+		return false;
+	}
+
+	return true;
+}
+
+bool ASpaceStationGameMode::LoadStation(const FString& SaveName)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationLoad);
+
+	FStationSaveReader Reader;
+	if (!Reader.Open(GetStationSavePath(SaveName)))
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Failed to load station '%s'."), *SaveName);
+		return false;
+	}
+
+	CreateStationGrid();
+	if (!StationGrid)
+		return false;
+
+	const FStationSaveView& Save = Reader.GetView();
+
+	// Resolve the class table up front; modules of classes that no longer load are dropped
+	TArray<UClass*> ModuleClasses;
+	ModuleClasses.Reserve(Save.ClassPaths.Num());
+	for (const FString& ClassPath : Save.ClassPaths)
+	{
+		UClass* ModuleClass = FSoftClassPath(ClassPath).TryLoadClass<AStationModule>();
+		if (!ModuleClass)
+		{
+			UE_LOG(LogTestGame4, Warning, TEXT("Station save '%s' references missing module class %s."), *SaveName, *ClassPath);
+		}
+		ModuleClasses.Add(ModuleClass);
+	}
+
+	ClearStation();
+
+	CurrentCredits = Save.Credits;
+	CurrentFood = Save.Food;
+
+	TGuardValue<bool> RestoringGuard(bRestoringStation, true);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<FStationModulePlacement> Placements;
+	Placements.Reserve(Save.ModuleClasses.Num());
+	for (int32 Index = 0; Index < Save.ModuleClasses.Num(); ++Index)
+	{
+		const uint16 ClassId = Save.ModuleClasses[Index];
+		UClass* ModuleClass = ModuleClasses.IsValidIndex(ClassId) ? ModuleClasses[ClassId] : nullptr;
+		if (!ModuleClass)
+			continue;
+
+		const FIntPoint GridCoord = Save.ModulePositions[Index];
+		const FRotator Rotation(0.0f, (Save.ModuleRotations[Index] & 3) * 90.0f, 0.0f);
+
+		INC_DWORD_STAT(STAT_StationActorsSpawned);
+		AStationModule* Module = GetWorld()->SpawnActor<AStationModule>(ModuleClass, StationGrid->GridToWorld(GridCoord), Rotation, SpawnParams);
+		if (Module)
+		{
+			Placements.Emplace(Module, GridCoord, Rotation);
+		}
+	}
+
+	// One grid commit and connection pass, then one systems update for the whole station
+	TArray<AStationModule*> Placed;
+	StationGrid->RestoreModules(Placements, Placed);
+
+	for (const FStationModulePlacement& Placement : Placements)
+	{
+		if (!Placement.Module->bIsPlaced)
+		{
+			Placement.Module->Destroy();
+		}
+	}
+
+	for (AStationModule* Module : Placed)
+	{
+		ModuleRegistry.Add(Module);
+	}
+
+	if (StationSystemsComponent)
+	{
+		StationSystemsComponent->OnModulesRegistered(Placed);
+	}
+
+	for (int32 Index = 0; Index < Save.CrewLocations.Num(); ++Index)
+	{
+		ACrewMember* Crew = SpawnCrewMember(FVector(Save.CrewLocations[Index]));
+		UCrewNeedsComponent* Needs = Crew ? Crew->GetNeedsComponent() : nullptr;
+		if (!Needs)
+			continue;
+
+		const FVector4f& SavedNeeds = Save.CrewNeeds[Index];
+		Needs->Oxygen = SavedNeeds.X;
+		Needs->Food = SavedNeeds.Y;
+		Needs->Sleep = SavedNeeds.Z;
+		Needs->Health = SavedNeeds.W;
+		Needs->bIsAlive = Save.CrewAlive[Index] != 0;
+		Needs->NotifyNeedsChanged();
+	}
+
+	if (NotificationSystem)
+	{
+		NotificationSystem->AddNotification(
+			FText::FromString(FString::Printf(TEXT("Station loaded: %d modules, %d crew"), Placed.Num(), AllCrew.Num())),
+			ENotificationPriority::Info, 3.0f);
+	}
+
+	return true;
+}
+
+void ASpaceStationGameMode::ClearStation()
+{
+	// Detach everything from the registries first so no system reacts to the actors going away
+	const TArray<AStationModule*> Modules = ModuleRegistry.GetAll();
+	const TArray<ACrewMember*> Crew = MoveTemp(AllCrew);
+	AllCrew.Reset();
+	ModuleRegistry.Reset();
+
+	if (StationSystemsComponent)
+	{
+		StationSystemsComponent->ResetSystems();
+	}
+
+	if (StationGrid)
+	{
+		StationGrid->ClearGrid();
+	}
+
+	// Player controllers keep raw selection pointers into the old station
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (ASpaceStationPlayerController* PC = Cast<ASpaceStationPlayerController>(It->Get()))
+		{
+			PC->DeselectAllCrew();
+			PC->HighlightedModule = nullptr;
+		}
+	}
+
+	for (AStationModule* Module : Modules)
+	{
+		if (Module)
+		{
+			Module->Destroy();
+		}
+	}
+
+	for (ACrewMember* CrewMember : Crew)
+	{
+		if (CrewMember)
+		{
+			CrewMember->Destroy();
+		}
+	}
+}
+
+FString ASpaceStationGameMode::GetStationSavePath(const FString& SaveName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Stations") / (SaveName + TEXT(".station"));
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "StationModuleRegistry.h"
 #include "SpaceStationGameMode.generated.h"
 
 class AStationGrid;
@@ -38,12 +39,15 @@ protected:
 	/** Pointer to the spawned Station Grid */
 	AStationGrid* StationGrid;
 
-	/** Registry of all placed modules */
-	TArray<AStationModule*> AllModules;
+	/** Registry of all placed modules, flat and bucketed by type */
+	FStationModuleRegistry ModuleRegistry;
 
 	/** Registry of all crew members */
 	TArray<ACrewMember*> AllCrew;
 
+	/** Set while a saved station is spawned, to hold back per-actor notifications */
+	bool bRestoringStation = false;
+
 	/** Current power available */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Resources")
 	int32 CurrentPower = 0;
@@ -104,6 +108,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Station")
 	void RegisterModule(AStationModule* Module);
 
+	/** Registers a batch of placed modules, updating station systems and notifying once for the whole batch */
+	UFUNCTION(BlueprintCallable, Category="Station")
+	void RegisterModules(const TArray<AStationModule*>& Modules);
+
 	/** Unregisters a module from the game mode */
 	UFUNCTION(BlueprintCallable, Category="Station")
 	void UnregisterModule(AStationModule* Module);
@@ -134,7 +142,10 @@ public:
 
 	/** Returns all modules */
 	UFUNCTION(BlueprintPure, Category="Station")
-	const TArray<AStationModule*>& GetAllModules() const { return AllModules; }
+	const TArray<AStationModule*>& GetAllModules() const { return ModuleRegistry.GetAll(); }
+
+	/** Returns all modules of one type without copying (invalidated by the next register/unregister) */
+	TConstArrayView<AStationModule*> GetModulesOfType(EStationModuleType ModuleType) const { return ModuleRegistry.GetByType(ModuleType); }
 
 	/** Returns all crew */
 	const TArray<ACrewMember*>& GetAllCrew() const { return AllCrew; }
@@ -171,12 +182,32 @@ public:
 	UFUNCTION(BlueprintPure, Category="Station")
 	UStationNotificationSystem* GetNotificationSystem() const { return NotificationSystem; }
 
-	/** Recalculate station systems (call after module changes) */
+	/** Rebuild station systems from scratch (module changes are tracked incrementally; see AStationModule::NotifySystemStatsChanged) */
 	UFUNCTION(BlueprintCallable, Category="Station")
 	void RecalculateSystems();
 
+	/**
+	 * Save the module layout, crew needs and economy to Saved/Stations/<SaveName>.station.
+	 * Power and oxygen totals are derived from the modules and are not stored.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Station")
+	bool SaveStation(const FString& SaveName);
+
+	/**
+	 * Replace the current station with a saved one.
+	 * Modules are bulk-spawned and committed to the grid first; connections and station systems are then updated once.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Station")
+	bool LoadStation(const FString& SaveName);
+
 protected:
 
 	/** Creates and spawns the station grid */
 	void CreateStationGrid();
+
+	/** Destroys every module and crew member and resets the grid and station systems */
+	void ClearStation();
+
+	/** File a station save with this name is written to */
+	static FString GetStationSavePath(const FString& SaveName);
 };
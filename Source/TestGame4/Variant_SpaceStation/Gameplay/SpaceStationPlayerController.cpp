@@ -15,6 +15,11 @@
 #include "InputActionValue.h"
 #include "InputModifiers.h"
 #include "Engine/World.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Player Controller Tick"), STAT_StationPlayerControllerTick, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Build Preview"), STAT_StationBuildPreview, STATGROUP_SpaceStation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor Traces"), STAT_StationTraces, STATGROUP_SpaceStation);
 
 ASpaceStationPlayerController::ASpaceStationPlayerController()
 {
@@ -185,6 +190,7 @@ void ASpaceStationPlayerController::SetupInputComponent()
 		EIC->BindAction(ResetCameraAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnResetCamera);
 		EIC->BindAction(SelectAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnSelect);
 		EIC->BindAction(PlaceModuleAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnPlaceModule);
+		EIC->BindAction(PlaceModuleAction, ETriggerEvent::Completed, this, &ASpaceStationPlayerController::OnPlaceModuleReleased);
 		EIC->BindAction(CancelPlacementAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnCancelPlacement);
 		EIC->BindAction(RotatePreviewAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnRotatePreview);
 		EIC->BindAction(CommandCrewAction, ETriggerEvent::Started, this, &ASpaceStationPlayerController::OnCommandCrew);
@@ -227,6 +233,8 @@ void ASpaceStationPlayerController::BeginPlay()
 
 void ASpaceStationPlayerController::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationPlayerControllerTick);
+
 	Super::Tick(DeltaSeconds);
 
 	// Lazy-initialize StationGrid (OnPossess runs before GameMode::BeginPlay)
@@ -271,7 +279,9 @@ void ASpaceStationPlayerController::EnterBuildMode(TSubclassOf<AStationModule> M
 	// Spawn preview module
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	INC_DWORD_STAT(STAT_StationActorsSpawned);
 	PreviewModule = GetWorld()->SpawnActor<AStationModule>(ModuleClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	bHasShownPreview = false;
 	if (PreviewModule)
 	{
 		PreviewModule->SetPreviewMode(true);
@@ -281,6 +291,7 @@ void ASpaceStationPlayerController::EnterBuildMode(TSubclassOf<AStationModule> M
 void ASpaceStationPlayerController::ExitBuildMode()
 {
 	bInBuildMode = false;
+	bDragBuilding = false;
 	SelectedModuleClass = nullptr;
 	PreviewRotation = FRotator::ZeroRotator;
 
@@ -294,21 +305,29 @@ void ASpaceStationPlayerController::ExitBuildMode()
 
 void ASpaceStationPlayerController::UpdateBuildPreview()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationBuildPreview);
+
 	if (!PreviewModule || !StationGrid)
 	{
 		return;
 	}
 
 	FIntPoint GridCoord;
-	if (GetGridLocationUnderCursor(GridCoord))
+	if (GetBuildCursorTile(GridCoord))
 	{
-		FVector WorldPos = StationGrid->GridToWorld(GridCoord);
-		PreviewModule->SetActorLocation(WorldPos);
-		PreviewModule->SetActorRotation(PreviewRotation);
+		// Only move the preview when it lands on another tile or was rotated
+		if (!bHasShownPreview || GridCoord != ShownPreviewTile || !PreviewRotation.Equals(ShownPreviewRotation))
+		{
+			FVector WorldPos = StationGrid->GridToWorld(GridCoord);
+			PreviewModule->SetActorLocation(WorldPos);
+			PreviewModule->SetActorRotation(PreviewRotation);
+			ShownPreviewTile = GridCoord;
+			ShownPreviewRotation = PreviewRotation;
+		}
 
-		bool bValid = StationGrid->IsValidPlacement(PreviewModule, GridCoord, PreviewRotation);
+		bool bValid = IsPreviewPlacementValid(GridCoord);
 
-		// Also check if player can afford this module
+		// Also check if player can afford this module (resources change without the grid changing)
 		if (bValid)
 		{
 			if (ASpaceStationGameMode* GM = GetWorld()->GetAuthGameMode<ASpaceStationGameMode>())
@@ -317,8 +336,74 @@ void ASpaceStationPlayerController::UpdateBuildPreview()
 			}
 		}
 
-		PreviewModule->SetValidPlacement(bValid);
+		// Only write the material parameter when the tint actually flips
+		if (!bHasShownPreview || bValid != bShownPreviewValid)
+		{
+			PreviewModule->SetValidPlacement(bValid);
+			bShownPreviewValid = bValid;
+		}
+
+		bHasShownPreview = true;
+	}
+}
+
+bool ASpaceStationPlayerController::GetBuildCursorTile(FIntPoint& OutGridCoord)
+{
+	if (!StationGrid)
+		return false;
+
+	float MouseX, MouseY;
+	if (!GetMousePosition(MouseX, MouseY))
+		return false;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Placing or removing modules changes what the cursor trace hits, so the grid revision is part of the key
+	const FVector2D CursorPosition(MouseX, MouseY);
+	const uint32 Revision = StationGrid->GetRevision();
+	if (Revision != BuildCursorRevision || CursorPosition != BuildCursorPosition
+		|| !ViewLocation.Equals(BuildCursorViewLocation) || !ViewRotation.Equals(BuildCursorViewRotation))
+	{
+		BuildCursorRevision = Revision;
+		BuildCursorPosition = CursorPosition;
+		BuildCursorViewLocation = ViewLocation;
+		BuildCursorViewRotation = ViewRotation;
+		bBuildCursorHit = GetGridLocationUnderCursor(BuildCursorTile);
 	}
+
+	OutGridCoord = BuildCursorTile;
+	return bBuildCursorHit;
+}
+
+bool ASpaceStationPlayerController::IsPreviewPlacementValid(const FIntPoint& GridCoord)
+{
+	// Every cached result depends on the grid contents and the module's footprint
+	const uint32 Revision = StationGrid->GetRevision();
+	UClass* ModuleClass = PreviewModule->GetClass();
+	if (Revision != PlacementCacheRevision || ModuleClass != PlacementCacheClass)
+	{
+		PlacementValidityCache.Reset();
+		PlacementCacheRevision = Revision;
+		PlacementCacheClass = ModuleClass;
+	}
+
+	const TPair<FIntPoint, int32> Key(GridCoord, FMath::RoundToInt(PreviewRotation.Yaw / 90.0f) & 3);
+	if (const bool* CachedValid = PlacementValidityCache.Find(Key))
+	{
+		return *CachedValid;
+	}
+
+	// Keep the cache bounded while sweeping the cursor across a huge station
+	if (PlacementValidityCache.Num() >= 4096)
+	{
+		PlacementValidityCache.Reset();
+	}
+
+	const bool bValid = StationGrid->IsValidPlacement(PreviewModule, GridCoord, PreviewRotation);
+	PlacementValidityCache.Add(Key, bValid);
+	return bValid;
 }
 
 void ASpaceStationPlayerController::PlaceModule()
@@ -358,7 +443,9 @@ void ASpaceStationPlayerController::PlaceModule()
 				{
 					FActorSpawnParameters SpawnParams;
 					SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+					INC_DWORD_STAT(STAT_StationActorsSpawned);
 					PreviewModule = GetWorld()->SpawnActor<AStationModule>(SelectedModuleClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+					bHasShownPreview = false;
 					if (PreviewModule)
 					{
 						PreviewModule->SetPreviewMode(true);
@@ -369,6 +456,78 @@ void ASpaceStationPlayerController::PlaceModule()
 	}
 }
 
+bool ASpaceStationPlayerController::PlaceModuleLine(const FIntPoint& StartTile, const FIntPoint& EndTile)
+{
+	if (!PreviewModule || !StationGrid || !SelectedModuleClass)
+		return false;
+
+	// Step by the footprint along whichever axis the drag covered more of
+	const FIntPoint Size = PreviewModule->GetRotatedSize(PreviewRotation);
+	const FIntPoint Delta = EndTile - StartTile;
+	const bool bAlongX = FMath::Abs(Delta.X) >= FMath::Abs(Delta.Y);
+	const FIntPoint Step = bAlongX
+		? FIntPoint(Delta.X < 0 ? -Size.X : Size.X, 0)
+		: FIntPoint(0, Delta.Y < 0 ? -Size.Y : Size.Y);
+	const int32 LineLength = FMath::Min(FMath::Abs(bAlongX ? Delta.X : Delta.Y) / FMath::Max(bAlongX ? Size.X : Size.Y, 1) + 1, MaxDragBuildModules);
+
+	// Clip out tiles that are already built on, e.g. the module a corridor extension starts from
+	TArray<FIntPoint> Tiles;
+	Tiles.Reserve(LineLength);
+	for (int32 Index = 0; Index < LineLength; ++Index)
+	{
+		const FIntPoint Tile = StartTile + Step * Index;
+		if (!StationGrid->IsGridPositionOccupied(Tile, Size))
+		{
+			Tiles.Add(Tile);
+		}
+	}
+
+	const int32 Count = Tiles.Num();
+	if (Count == 0)
+		return false;
+
+	ASpaceStationGameMode* GM = GetWorld()->GetAuthGameMode<ASpaceStationGameMode>();
+	const int32 TotalCost = PreviewModule->BuildCost * Count;
+	if (GM && !GM->CanAffordModule(TotalCost))
+		return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AStationModule*> Modules;
+	TArray<FStationModulePlacement> Placements;
+	Modules.Reserve(Count);
+	Placements.Reserve(Count);
+	for (const FIntPoint& Tile : Tiles)
+	{
+		INC_DWORD_STAT(STAT_StationActorsSpawned);
+		AStationModule* Module = GetWorld()->SpawnActor<AStationModule>(SelectedModuleClass, StationGrid->GridToWorld(Tile), PreviewRotation, SpawnParams);
+		if (!Module)
+			continue;
+
+		Modules.Add(Module);
+		Placements.Emplace(Module, Tile, PreviewRotation);
+	}
+
+	// All or nothing: one grid commit, one connection pass and one systems update for the whole line
+	if (Modules.Num() != Count || !StationGrid->PlaceModules(Placements))
+	{
+		for (AStationModule* Module : Modules)
+		{
+			Module->Destroy();
+		}
+		return false;
+	}
+
+	if (GM)
+	{
+		GM->PayForModule(TotalCost);
+		GM->RegisterModules(Modules);
+	}
+
+	return true;
+}
+
 void ASpaceStationPlayerController::RotatePreview()
 {
 	// Rotate by 90 degrees
@@ -384,6 +543,7 @@ bool ASpaceStationPlayerController::GetGridLocationUnderCursor(FIntPoint& OutGri
 		return false;
 
 	FHitResult HitResult;
+	INC_DWORD_STAT(STAT_StationTraces);
 	bool bHit = GetHitResultUnderCursor(ECC_Visibility, false, HitResult);
 
 	if (bHit)
@@ -509,6 +669,7 @@ void ASpaceStationPlayerController::OnSelect(const FInputActionValue& Value)
 		bool bShiftHeld = IsInputKeyDown(EKeys::LeftShift) || IsInputKeyDown(EKeys::RightShift);
 
 		FHitResult HitResult;
+		INC_DWORD_STAT(STAT_StationTraces);
 		if (GetHitResultUnderCursor(ECC_Pawn, false, HitResult))
 		{
 			ACrewMember* HitCrew = Cast<ACrewMember>(HitResult.GetActor());
@@ -530,9 +691,27 @@ void ASpaceStationPlayerController::OnSelect(const FInputActionValue& Value)
 void ASpaceStationPlayerController::OnPlaceModule(const FInputActionValue& Value)
 {
 	if (bInBuildMode)
+	{
+		// Placement happens on release so a press-drag-release can lay a whole line
+		bDragBuilding = GetGridLocationUnderCursor(DragStartTile);
+	}
+}
+
+void ASpaceStationPlayerController::OnPlaceModuleReleased(const FInputActionValue& Value)
+{
+	if (!bInBuildMode || !bDragBuilding)
+		return;
+
+	bDragBuilding = false;
+
+	FIntPoint EndTile;
+	if (!GetGridLocationUnderCursor(EndTile) || EndTile == DragStartTile)
 	{
 		PlaceModule();
+		return;
 	}
+
+	PlaceModuleLine(DragStartTile, EndTile);
 }
 
 void ASpaceStationPlayerController::OnCancelPlacement(const FInputActionValue& Value)
@@ -565,6 +744,7 @@ void ASpaceStationPlayerController::OnCommandCrew(const FInputActionValue& Value
 		return;
 
 	FHitResult HitResult;
+	INC_DWORD_STAT(STAT_StationTraces);
 	if (GetHitResultUnderCursor(ECC_Visibility, false, HitResult))
 	{
 		CommandCrewMove(HitResult.Location);
@@ -689,6 +869,7 @@ void ASpaceStationPlayerController::SpawnCrewAtCursor()
 		return;
 
 	FHitResult HitResult;
+	INC_DWORD_STAT(STAT_StationTraces);
 	if (GetHitResultUnderCursor(ECC_Visibility, false, HitResult))
 	{
 		FVector CrewSpawnPos = HitResult.Location;
@@ -114,6 +114,16 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Building")
 	bool bInDeleteMode = false;
 
+	/** Most modules a single drag-to-build line may place */
+	UPROPERTY(EditAnywhere, Category="Building", meta=(ClampMin=1))
+	int32 MaxDragBuildModules = 256;
+
+	/** Set while the place button is held in build mode; the line is placed on release */
+	bool bDragBuilding = false;
+
+	/** Tile the current drag started on */
+	FIntPoint DragStartTile = FIntPoint::ZeroValue;
+
 	/** Selected module class to build */
 	TSubclassOf<AStationModule> SelectedModuleClass;
 
@@ -123,6 +133,25 @@ protected:
 	/** Current rotation for preview module */
 	FRotator PreviewRotation = FRotator::ZeroRotator;
 
+	/** Placement validity per (tile, quarter turns), valid for PlacementCacheClass at PlacementCacheRevision */
+	TMap<TPair<FIntPoint, int32>, bool> PlacementValidityCache;
+	UClass* PlacementCacheClass = nullptr;
+	uint32 PlacementCacheRevision = 0;
+
+	/** What the preview module currently shows, so transforms and material writes only happen on change */
+	FIntPoint ShownPreviewTile = FIntPoint::ZeroValue;
+	FRotator ShownPreviewRotation = FRotator::ZeroRotator;
+	bool bShownPreviewValid = false;
+	bool bHasShownPreview = false;
+
+	/** Cursor position, view and grid revision of the last build cursor trace, and the tile it hit */
+	FVector2D BuildCursorPosition = FVector2D::ZeroVector;
+	FVector BuildCursorViewLocation = FVector::ZeroVector;
+	FRotator BuildCursorViewRotation = FRotator::ZeroRotator;
+	uint32 BuildCursorRevision = 0;
+	FIntPoint BuildCursorTile = FIntPoint::ZeroValue;
+	bool bBuildCursorHit = false;
+
 	/** Selected crew members */
 	TArray<ACrewMember*> SelectedCrew;
 
@@ -167,6 +196,14 @@ public:
 	/** Place the current preview module */
 	void PlaceModule();
 
+	/**
+	 * Place a straight line of the selected module from StartTile towards EndTile along the dominant axis,
+	 * spaced by the module footprint. Tiles already built on are skipped, so a drag may start on the station;
+	 * the rest of the line is validated, paid for and registered as one batch.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Building")
+	bool PlaceModuleLine(const FIntPoint& StartTile, const FIntPoint& EndTile);
+
 	/** Rotate the preview module 90 degrees */
 	void RotatePreview();
 
@@ -228,6 +265,12 @@ public:
 	/** Update delete mode preview (highlight module under cursor) */
 	void UpdateDeletePreview();
 
+	/** Grid tile under the cursor, re-traced only when the cursor, the view or the grid changed */
+	bool GetBuildCursorTile(FIntPoint& OutGridCoord);
+
+	/** Memoized StationGrid->IsValidPlacement for the preview module */
+	bool IsPreviewPlacementValid(const FIntPoint& GridCoord);
+
 	/** Currently highlighted module for deletion */
 	AStationModule* HighlightedModule = nullptr;
 
@@ -239,6 +282,7 @@ protected:
 	void OnResetCamera(const FInputActionValue& Value);
 	void OnSelect(const FInputActionValue& Value);
 	void OnPlaceModule(const FInputActionValue& Value);
+	void OnPlaceModuleReleased(const FInputActionValue& Value);
 	void OnCancelPlacement(const FInputActionValue& Value);
 	void OnRotatePreview(const FInputActionValue& Value);
 	void OnCommandCrew(const FInputActionValue& Value);
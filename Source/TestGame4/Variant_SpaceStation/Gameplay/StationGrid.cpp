@@ -3,26 +3,64 @@
 #include "StationGrid.h"
 #include "StationModule.h"
 #include "SpaceStationGameMode.h"
-#include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Grid Tick"), STAT_StationGridTick, STATGROUP_SpaceStation);
+DECLARE_CYCLE_STAT(TEXT("Grid Place Batch"), STAT_StationGridPlaceBatch, STATGROUP_SpaceStation);
+DECLARE_MEMORY_STAT(TEXT("Grid Storage"), STAT_StationGridMemory, STATGROUP_SpaceStation);
 
 AStationGrid::AStationGrid()
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	GridLines = CreateDefaultSubobject<ULineBatchComponent>(TEXT("GridLines"));
+	RootComponent = GridLines;
+}
+
+void AStationGrid::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_StationGridMemory, ReportedMemory, 0);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AStationGrid::Tick(float DeltaSeconds)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationGridTick);
+
 	Super::Tick(DeltaSeconds);
 
-	// Draw debug grid if enabled
-	if (bShowGrid)
+	if (GridLines->IsVisible() != bShowGrid)
+	{
+		GridLines->SetVisibility(bShowGrid);
+	}
+
+	if (!bShowGrid)
+		return;
+
+	// Lines persist in the batch; only rebuild when the camera reveals a new range or settings changed
+	const FIntRect TileRect = GetVisibleTileRect();
+	if (bGridLinesDirty || TileRect != DrawnTileRect)
 	{
-		DrawDebugGrid();
+		bGridLinesDirty = false;
+		DrawnTileRect = TileRect;
+		DrawDebugGrid(TileRect);
 	}
 }
 
+#if WITH_EDITOR
+void AStationGrid::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	bGridLinesDirty = true;
+}
+#endif
+
 FIntPoint AStationGrid::WorldToGrid(const FVector& WorldLocation) const
 {
 	FVector RelativeLocation = WorldLocation - GridOrigin;
@@ -41,19 +79,8 @@ FVector AStationGrid::GridToWorld(const FIntPoint& GridCoord) const
 
 bool AStationGrid::IsGridPositionOccupied(const FIntPoint& GridCoord, const FIntPoint& Size) const
 {
-	// Check if all tiles in the module's footprint are free
-	for (int32 X = 0; X < Size.X; ++X)
-	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
-		{
-			FIntPoint CheckCoord = GridCoord + FIntPoint(X, Y);
-			if (GridMap.Contains(CheckCoord))
-			{
-				return true; // Occupied
-			}
-		}
-	}
-	return false; // All tiles free
+	// Check if all tiles in the module's footprint are free (one mask test per footprint row)
+	return GridCells.IsRectOccupied(GridCoord, Size);
 }
 
 bool AStationGrid::IsValidPlacement(AStationModule* Module, const FIntPoint& GridCoord, const FRotator& Rotation)
@@ -67,7 +94,7 @@ bool AStationGrid::IsValidPlacement(AStationModule* Module, const FIntPoint& Gri
 		return false;
 
 	// Check connectivity (if not first module)
-	if (GridMap.Num() > 0)
+	if (GridCells.Num() > 0)
 	{
 		if (!CheckAdjacentConnection(GridCoord, Size))
 			return false;
@@ -91,16 +118,10 @@ bool AStationGrid::PlaceModule(AStationModule* Module, const FIntPoint& GridCoor
 	Module->SetActorLocation(WorldPos);
 	Module->SetActorRotation(Rotation);
 
-	// Add to grid map
-	FIntPoint Size = Module->GetRotatedSize(Rotation);
-	for (int32 X = 0; X < Size.X; ++X)
-	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
-		{
-			FIntPoint MapCoord = GridCoord + FIntPoint(X, Y);
-			GridMap.Add(MapCoord, Module);
-		}
-	}
+	// Add to grid storage
+	GridCells.Fill(GridCoord, Module->GetRotatedSize(Rotation), Module);
+	++Revision;
+	ReportMemory();
 
 	// Update connections on the new module
 	Module->UpdateConnections();
@@ -117,6 +138,177 @@ bool AStationGrid::PlaceModule(AStationModule* Module, const FIntPoint& GridCoor
 	return true;
 }
 
+bool AStationGrid::PlaceModules(const TArray<FStationModulePlacement>& Placements)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationGridPlaceBatch);
+
+	if (Placements.Num() == 0)
+		return false;
+
+	const int32 NumPlacements = Placements.Num();
+	TArray<FIntPoint> Sizes;
+	Sizes.Reserve(NumPlacements);
+
+	// Seeds are placements touching the existing station; an empty grid lets the first placement start it
+	TBitArray<> Reached(false, NumPlacements);
+	TArray<int32> Queue;
+	Queue.Reserve(NumPlacements);
+
+	TMap<const AStationModule*, int32> PlacementIndices;
+	PlacementIndices.Reserve(NumPlacements);
+
+	const bool bGridWasEmpty = GridCells.Num() == 0;
+	for (int32 Index = 0; Index < NumPlacements; ++Index)
+	{
+		const FStationModulePlacement& Placement = Placements[Index];
+		if (!Placement.Module || PlacementIndices.Contains(Placement.Module))
+			return false;
+
+		PlacementIndices.Add(Placement.Module, Index);
+
+		const FIntPoint Size = Placement.Module->GetRotatedSize(Placement.Rotation);
+		if (GridCells.IsRectOccupied(Placement.GridCoord, Size))
+			return false;
+
+		Sizes.Add(Size);
+
+		if ((bGridWasEmpty && Index == 0) || (!bGridWasEmpty && GridCells.IsRectAdjacentToOccupied(Placement.GridCoord, Size)))
+		{
+			Reached[Index] = true;
+			Queue.Add(Index);
+		}
+	}
+
+	// Claim the footprints, backing out on the first overlap inside the batch
+	for (int32 Index = 0; Index < NumPlacements; ++Index)
+	{
+		const FStationModulePlacement& Placement = Placements[Index];
+		if (GridCells.IsRectOccupied(Placement.GridCoord, Sizes[Index]))
+		{
+			for (int32 Filled = 0; Filled < Index; ++Filled)
+			{
+				GridCells.Clear(Placements[Filled].GridCoord, Sizes[Filled]);
+			}
+			return false;
+		}
+
+		GridCells.Fill(Placement.GridCoord, Sizes[Index], Placement.Module);
+	}
+
+	// Spread connectivity from the seeds through batch modules that share an edge
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Index = Queue[Head];
+		const FIntPoint Origin = Placements[Index].GridCoord;
+		const FIntPoint Size = Sizes[Index];
+
+		auto Visit = [this, &PlacementIndices, &Reached, &Queue](const FIntPoint& Cell)
+		{
+			const int32* Neighbor = PlacementIndices.Find(GridCells.Get(Cell));
+			if (Neighbor && !Reached[*Neighbor])
+			{
+				Reached[*Neighbor] = true;
+				Queue.Add(*Neighbor);
+			}
+		};
+
+		for (int32 X = Origin.X; X < Origin.X + Size.X; ++X)
+		{
+			Visit(FIntPoint(X, Origin.Y - 1));
+			Visit(FIntPoint(X, Origin.Y + Size.Y));
+		}
+		for (int32 Y = Origin.Y; Y < Origin.Y + Size.Y; ++Y)
+		{
+			Visit(FIntPoint(Origin.X - 1, Y));
+			Visit(FIntPoint(Origin.X + Size.X, Y));
+		}
+	}
+
+	if (Queue.Num() != NumPlacements)
+	{
+		for (int32 Index = 0; Index < NumPlacements; ++Index)
+		{
+			GridCells.Clear(Placements[Index].GridCoord, Sizes[Index]);
+		}
+		return false;
+	}
+
+	++Revision;
+	ReportMemory();
+
+	for (const FStationModulePlacement& Placement : Placements)
+	{
+		AStationModule* Module = Placement.Module;
+		Module->GridPosition = Placement.GridCoord;
+		Module->GridRotation = Placement.Rotation;
+		Module->SetActorLocation(GridToWorld(Placement.GridCoord));
+		Module->SetActorRotation(Placement.Rotation);
+
+		// Leaves preview state: collision on, opaque, marked placed
+		Module->SetPreviewMode(false);
+	}
+
+	// Every placed module sees the whole batch, so one pass over them plus one over the outside neighbours is enough
+	TSet<AStationModule*> Neighbors;
+	for (const FStationModulePlacement& Placement : Placements)
+	{
+		Placement.Module->UpdateConnections();
+
+		for (AStationModule* Connected : Placement.Module->ConnectedModules)
+		{
+			if (Connected && !PlacementIndices.Contains(Connected))
+			{
+				Neighbors.Add(Connected);
+			}
+		}
+	}
+
+	for (AStationModule* Neighbor : Neighbors)
+	{
+		Neighbor->UpdateConnections();
+	}
+
+	return true;
+}
+
+void AStationGrid::RestoreModules(TConstArrayView<FStationModulePlacement> Placements, TArray<AStationModule*>& OutPlaced)
+{
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationGridPlaceBatch);
+
+	OutPlaced.Reserve(OutPlaced.Num() + Placements.Num());
+	for (const FStationModulePlacement& Placement : Placements)
+	{
+		AStationModule* Module = Placement.Module;
+		if (!Module)
+			continue;
+
+		const FIntPoint Size = Module->GetRotatedSize(Placement.Rotation);
+		if (GridCells.IsRectOccupied(Placement.GridCoord, Size))
+			continue;
+
+		GridCells.Fill(Placement.GridCoord, Size, Module);
+		Module->GridPosition = Placement.GridCoord;
+		Module->GridRotation = Placement.Rotation;
+		Module->SetPreviewMode(false);
+		OutPlaced.Add(Module);
+	}
+
+	++Revision;
+	ReportMemory();
+
+	// Neighbours are all restored too, so each module only needs its own pass
+	for (AStationModule* Module : OutPlaced)
+	{
+		Module->UpdateConnections();
+	}
+}
+
+void AStationGrid::ClearGrid()
+{
+	GridCells.Reset();
+	++Revision;
+}
+
 void AStationGrid::RemoveModule(const FIntPoint& GridCoord)
 {
 	AStationModule* Module = GetModuleAt(GridCoord);
@@ -129,16 +321,9 @@ void AStationGrid::RemoveModule(const FIntPoint& GridCoord)
 		GM->UnregisterModule(Module);
 	}
 
-	// Remove from grid map
-	FIntPoint Size = Module->GetRotatedSize(Module->GridRotation);
-	for (int32 X = 0; X < Size.X; ++X)
-	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
-		{
-			FIntPoint MapCoord = Module->GridPosition + FIntPoint(X, Y);
-			GridMap.Remove(MapCoord);
-		}
-	}
+	// Remove from grid storage
+	GridCells.Clear(Module->GridPosition, Module->GetRotatedSize(Module->GridRotation));
+	++Revision;
 
 	// Update connections on neighboring modules
 	for (AStationModule* Connected : Module->ConnectedModules)
@@ -155,8 +340,7 @@ void AStationGrid::RemoveModule(const FIntPoint& GridCoord)
 
 AStationModule* AStationGrid::GetModuleAt(const FIntPoint& GridCoord) const
 {
-	AStationModule* const* FoundModule = GridMap.Find(GridCoord);
-	return FoundModule ? *FoundModule : nullptr;
+	return GridCells.Get(GridCoord);
 }
 
 TArray<AStationModule*> AStationGrid::GetAdjacentModules(const FIntPoint& GridCoord) const
@@ -183,48 +367,105 @@ TArray<AStationModule*> AStationGrid::GetAdjacentModules(const FIntPoint& GridCo
 	return Adjacent;
 }
 
-void AStationGrid::DrawDebugGrid_Implementation()
+void AStationGrid::DrawDebugGrid_Implementation(const FIntRect& TileRect)
 {
-	if (!GetWorld())
+	GridLines->Flush();
+
+	if (TileRect.Min.X > TileRect.Max.X || TileRect.Min.Y > TileRect.Max.Y)
 		return;
 
-	// Draw grid lines
-	float LineLifetime = 0.0f; // Draw for one frame
-	float LineThickness = 2.0f;
+	// Draw grid lines (zero lifetime keeps them until the next flush)
+	const float LineLifetime = 0.0f;
+	const float LineThickness = 2.0f;
 
-	int32 HalfSize = DebugGridSize / 2;
+	TArray<FBatchedLine> Lines;
+	Lines.Reserve((TileRect.Max.X - TileRect.Min.X + 1) + (TileRect.Max.Y - TileRect.Min.Y + 1));
 
 	// Draw horizontal lines
-	for (int32 Y = -HalfSize; Y <= HalfSize; ++Y)
+	for (int32 Y = TileRect.Min.Y; Y <= TileRect.Max.Y; ++Y)
 	{
-		FVector Start = GridToWorld(FIntPoint(-HalfSize, Y));
-		FVector End = GridToWorld(FIntPoint(HalfSize, Y));
-		DrawDebugLine(GetWorld(), Start, End, GridColor, false, LineLifetime, 0, LineThickness);
+		FVector Start = GridToWorld(FIntPoint(TileRect.Min.X, Y));
+		FVector End = GridToWorld(FIntPoint(TileRect.Max.X, Y));
+		Lines.Emplace(Start, End, FLinearColor(GridColor), LineLifetime, LineThickness, SDPG_World);
 	}
 
 	// Draw vertical lines
-	for (int32 X = -HalfSize; X <= HalfSize; ++X)
+	for (int32 X = TileRect.Min.X; X <= TileRect.Max.X; ++X)
 	{
-		FVector Start = GridToWorld(FIntPoint(X, -HalfSize));
-		FVector End = GridToWorld(FIntPoint(X, HalfSize));
-		DrawDebugLine(GetWorld(), Start, End, GridColor, false, LineLifetime, 0, LineThickness);
+		FVector Start = GridToWorld(FIntPoint(X, TileRect.Min.Y));
+		FVector End = GridToWorld(FIntPoint(X, TileRect.Max.Y));
+		Lines.Emplace(Start, End, FLinearColor(GridColor), LineLifetime, LineThickness, SDPG_World);
 	}
+
+	GridLines->DrawLines(Lines);
 }
 
-bool AStationGrid::CheckAdjacentConnection(const FIntPoint& GridCoord, const FIntPoint& Size) const
+FIntRect AStationGrid::GetVisibleTileRect() const
 {
-	// Check if any tile in the module's footprint is adjacent to an existing module
-	for (int32 X = 0; X < Size.X; ++X)
+	const int32 HalfSize = DebugGridSize / 2;
+	const FIntRect FullRect(-HalfSize, -HalfSize, HalfSize, HalfSize);
+
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	int32 ViewportX = 0;
+	int32 ViewportY = 0;
+	if (!PC || !PC->IsLocalController())
+		return FullRect;
+
+	PC->GetViewportSize(ViewportX, ViewportY);
+	if (ViewportX <= 0 || ViewportY <= 0)
+		return FullRect;
+
+	// Where the corners of the view hit the grid plane
+	FBox2D ViewBounds(ForceInit);
+	const FVector2D Corners[] = {
+		FVector2D(0.0f, 0.0f),
+		FVector2D(ViewportX, 0.0f),
+		FVector2D(0.0f, ViewportY),
+		FVector2D(ViewportX, ViewportY)
+	};
+
+	for (const FVector2D& Corner : Corners)
 	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
+		FVector RayOrigin;
+		FVector RayDirection;
+		if (!PC->DeprojectScreenPositionToWorld(Corner.X, Corner.Y, RayOrigin, RayDirection))
+			return FullRect;
+
+		float Distance = GridCullMaxDistance;
+		if (RayDirection.Z < -UE_KINDA_SMALL_NUMBER)
 		{
-			FIntPoint CheckCoord = GridCoord + FIntPoint(X, Y);
-			TArray<AStationModule*> Adjacent = GetAdjacentModules(CheckCoord);
-			if (Adjacent.Num() > 0)
-			{
-				return true; // Connected to at least one module
-			}
+			Distance = FMath::Clamp(static_cast<float>((GridOrigin.Z - RayOrigin.Z) / RayDirection.Z), 0.0f, GridCullMaxDistance);
 		}
+
+		ViewBounds += FVector2D(RayOrigin);
+		ViewBounds += FVector2D(RayOrigin + RayDirection * Distance);
 	}
-	return false; // Not connected to any module
+
+	const FIntPoint MinTile = WorldToGrid(FVector(ViewBounds.Min, GridOrigin.Z));
+	const FIntPoint MaxTile = WorldToGrid(FVector(ViewBounds.Max, GridOrigin.Z));
+
+	// Round outwards to whole snap blocks, then clip to the grid
+	const int32 Snap = FMath::Max(GridCullSnapTiles, 1);
+	FIntRect TileRect(
+		FMath::FloorToInt(static_cast<float>(MinTile.X) / Snap) * Snap,
+		FMath::FloorToInt(static_cast<float>(MinTile.Y) / Snap) * Snap,
+		FMath::CeilToInt(static_cast<float>(MaxTile.X) / Snap) * Snap,
+		FMath::CeilToInt(static_cast<float>(MaxTile.Y) / Snap) * Snap);
+
+	TileRect.Min.X = FMath::Max(TileRect.Min.X, FullRect.Min.X);
+	TileRect.Min.Y = FMath::Max(TileRect.Min.Y, FullRect.Min.Y);
+	TileRect.Max.X = FMath::Min(TileRect.Max.X, FullRect.Max.X);
+	TileRect.Max.Y = FMath::Min(TileRect.Max.Y, FullRect.Max.Y);
+	return TileRect;
+}
+
+bool AStationGrid::CheckAdjacentConnection(const FIntPoint& GridCoord, const FIntPoint& Size) const
+{
+	// Check if any tile in the module's footprint is adjacent to an existing module
+	return GridCells.IsRectAdjacentToOccupied(GridCoord, Size);
+}
+
+void AStationGrid::ReportMemory()
+{
+	TESTGAME4_REPORT_MEMORY_STAT(STAT_StationGridMemory, ReportedMemory, GridCells.GetAllocatedSize());
 }
@@ -4,9 +4,33 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "StationGridStorage.h"
 #include "StationGrid.generated.h"
 
 class AStationModule;
+class ULineBatchComponent;
+
+/**
+ * One module to place as part of a batch.
+ */
+USTRUCT(BlueprintType)
+struct FStationModulePlacement
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category="Grid")
+	AStationModule* Module = nullptr;
+
+	UPROPERTY(BlueprintReadWrite, Category="Grid")
+	FIntPoint GridCoord = FIntPoint::ZeroValue;
+
+	UPROPERTY(BlueprintReadWrite, Category="Grid")
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	FStationModulePlacement() {}
+	FStationModulePlacement(AStationModule* InModule, const FIntPoint& InGridCoord, const FRotator& InRotation)
+		: Module(InModule), GridCoord(InGridCoord), Rotation(InRotation) {}
+};
 
 /**
  * Grid-based building system manager for the space station.
@@ -19,8 +43,18 @@ class AStationGrid : public AActor
 
 protected:
 
-	/** Sparse grid storage - maps grid coordinates to placed modules */
-	TMap<FIntPoint, AStationModule*> GridMap;
+	/** Persistent grid overlay; rebuilt only when the visible tile range or grid settings change */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	ULineBatchComponent* GridLines;
+
+	/** Dense chunked grid storage - maps grid coordinates to placed modules */
+	FStationGridStorage GridCells;
+
+	/** Bumped whenever a cell changes owner, so callers can cache lookups against it */
+	uint32 Revision = 1;
+
+	/** Bytes of GridCells last reported to the grid memory stat */
+	SIZE_T ReportedMemory = 0;
 
 	/** Size of each grid tile in cm (200cm = 2m) */
 	UPROPERTY(EditAnywhere, Category="Grid")
@@ -42,14 +76,34 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Grid|Debug")
 	int32 DebugGridSize = 50;
 
+	/** The drawn range is rounded out to multiples of this many tiles so small camera moves don't rebuild it */
+	UPROPERTY(EditAnywhere, Category="Grid|Debug", meta=(ClampMin=1))
+	int32 GridCullSnapTiles = 16;
+
+	/** Furthest distance along a view ray the grid is drawn to, for views that reach the horizon */
+	UPROPERTY(EditAnywhere, Category="Grid|Debug")
+	float GridCullMaxDistance = 20000.0f;
+
+	/** Tile range currently in GridLines */
+	FIntRect DrawnTileRect;
+
+	/** Set when grid settings change so the overlay is rebuilt even if the visible range did not */
+	bool bGridLinesDirty = true;
+
 public:
 
 	/** Constructor */
 	AStationGrid();
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Tick for debug visualization */
 	virtual void Tick(float DeltaSeconds) override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 public:
 
 	/** Convert world location to grid coordinates */
@@ -72,6 +126,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Grid")
 	bool PlaceModule(AStationModule* Module, const FIntPoint& GridCoord, const FRotator& Rotation);
 
+	/**
+	 * Place a batch of modules (drag-to-build lines, blueprint stamps) atomically: either every module is placed or none are.
+	 * Modules may not overlap each other or the station, and each must connect to the station either directly
+	 * or through other modules of the batch. Placed modules leave preview mode (collision on), and connections
+	 * are updated once per affected module.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Grid")
+	bool PlaceModules(const TArray<FStationModulePlacement>& Placements);
+
+	/**
+	 * Put saved modules back in bulk. Connectivity is not re-validated, since a saved layout may be missing
+	 * modules whose class no longer loads; entries overlapping earlier ones are skipped and left unplaced.
+	 * Placed modules leave preview mode (collision on), and connections are updated once per module after
+	 * every footprint is in place.
+	 */
+	void RestoreModules(TConstArrayView<FStationModulePlacement> Placements, TArray<AStationModule*>& OutPlaced);
+
+	/** Forget every placed module without touching the actors (used when replacing the whole station) */
+	void ClearGrid();
+
 	/** Remove a module from the grid */
 	UFUNCTION(BlueprintCallable, Category="Grid")
 	void RemoveModule(const FIntPoint& GridCoord);
@@ -80,17 +154,26 @@ public:
 	UFUNCTION(BlueprintPure, Category="Grid")
 	AStationModule* GetModuleAt(const FIntPoint& GridCoord) const;
 
+	/** Changes every time a module is placed or removed; starts at 1 so callers can use 0 as "not cached" */
+	uint32 GetRevision() const { return Revision; }
+
 	/** Get adjacent modules (for connectivity checks) */
 	UFUNCTION(BlueprintPure, Category="Grid")
 	TArray<AStationModule*> GetAdjacentModules(const FIntPoint& GridCoord) const;
 
 protected:
 
-	/** Draw debug grid lines */
+	/** Rebuild the grid overlay for the tiles in TileRect (only called when it changes) */
 	UFUNCTION(BlueprintNativeEvent, Category="Grid|Debug")
-	void DrawDebugGrid();
-	virtual void DrawDebugGrid_Implementation();
+	void DrawDebugGrid(const FIntRect& TileRect);
+	virtual void DrawDebugGrid_Implementation(const FIntRect& TileRect);
+
+	/** Tiles of the debug grid the first local player can currently see, snapped to GridCullSnapTiles */
+	FIntRect GetVisibleTileRect() const;
 
 	/** Check if module is connected to existing station */
 	bool CheckAdjacentConnection(const FIntPoint& GridCoord, const FIntPoint& Size) const;
+
+	/** Report the current size of GridCells to the grid memory stat; storage only grows when cells are filled */
+	void ReportMemory();
 };
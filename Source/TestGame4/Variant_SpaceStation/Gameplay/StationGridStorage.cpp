@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationGridStorage.h"
+
+FStationGridStorage::FChunk::FChunk()
+{
+	for (uint32& Row : OccupiedRows)
+	{
+		Row = 0;
+	}
+	for (int32& Slot : ModuleSlots)
+	{
+		Slot = EmptySlot;
+	}
+}
+
+template<typename FunctorType>
+bool FStationGridStorage::ForEachChunkSpan(const FIntPoint& Origin, const FIntPoint& Size, FunctorType&& Func)
+{
+	if (Size.X <= 0 || Size.Y <= 0)
+		return false;
+
+	const FIntPoint Last = Origin + Size - FIntPoint(1, 1);
+	for (int32 ChunkY = ToChunk(Origin.Y); ChunkY <= ToChunk(Last.Y); ++ChunkY)
+	{
+		const int32 FirstY = FMath::Max(Origin.Y, ChunkY << ChunkShift);
+		const int32 LastY = FMath::Min(Last.Y, (ChunkY << ChunkShift) | ChunkMask);
+
+		for (int32 ChunkX = ToChunk(Origin.X); ChunkX <= ToChunk(Last.X); ++ChunkX)
+		{
+			const int32 FirstX = FMath::Max(Origin.X, ChunkX << ChunkShift);
+			const int32 LastX = FMath::Min(Last.X, (ChunkX << ChunkShift) | ChunkMask);
+
+			if (Func(FIntPoint(ChunkX, ChunkY), FIntPoint(FirstX, FirstY), FIntPoint(LastX, LastY)))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool FStationGridStorage::IsRectOccupied(const FIntPoint& Origin, const FIntPoint& Size) const
+{
+	return ForEachChunkSpan(Origin, Size, [this](const FIntPoint& ChunkCoord, const FIntPoint& First, const FIntPoint& Last)
+	{
+		const int32 ChunkIndex = FindChunk(ChunkCoord);
+		if (ChunkIndex == INDEX_NONE)
+			return false;
+
+		const FChunk& Chunk = Chunks[ChunkIndex];
+		const uint32 RowMask = MakeRowMask(First.X & ChunkMask, Last.X - First.X + 1);
+		for (int32 Y = First.Y; Y <= Last.Y; ++Y)
+		{
+			if (Chunk.OccupiedRows[Y & ChunkMask] & RowMask)
+				return true;
+		}
+		return false;
+	});
+}
+
+bool FStationGridStorage::IsRectAdjacentToOccupied(const FIntPoint& Origin, const FIntPoint& Size) const
+{
+	// Edge neighbours form a plus shape: the rows of the rectangle widened by one cell on each side,
+	// plus the row directly above and below it
+	return IsRectOccupied(Origin - FIntPoint(1, 0), Size + FIntPoint(2, 0))
+		|| IsRectOccupied(Origin - FIntPoint(0, 1), FIntPoint(Size.X, 1))
+		|| IsRectOccupied(FIntPoint(Origin.X, Origin.Y + Size.Y), FIntPoint(Size.X, 1));
+}
+
+void FStationGridStorage::Fill(const FIntPoint& Origin, const FIntPoint& Size, AStationModule* Module)
+{
+	if (!Module)
+		return;
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		Modules[Slot] = Module;
+	}
+	else
+	{
+		Slot = Modules.Add(Module);
+	}
+
+	ForEachChunkSpan(Origin, Size, [this, Slot](const FIntPoint& ChunkCoord, const FIntPoint& First, const FIntPoint& Last)
+	{
+		// May grow Chunks, so index only afterwards
+		const int32 ChunkIndex = FindOrAddChunk(ChunkCoord);
+		FChunk& Chunk = Chunks[ChunkIndex];
+		const uint32 RowMask = MakeRowMask(First.X & ChunkMask, Last.X - First.X + 1);
+		const int32 NumCells = (Last.X - First.X + 1) * (Last.Y - First.Y + 1);
+
+		for (int32 Y = First.Y; Y <= Last.Y; ++Y)
+		{
+			checkSlow((Chunk.OccupiedRows[Y & ChunkMask] & RowMask) == 0);
+			Chunk.OccupiedRows[Y & ChunkMask] |= RowMask;
+
+			for (int32 X = First.X; X <= Last.X; ++X)
+			{
+				Chunk.ModuleSlots[ToCellIndex(FIntPoint(X, Y))] = Slot;
+			}
+		}
+
+		Chunk.NumOccupied += NumCells;
+		NumOccupied += NumCells;
+		return false;
+	});
+}
+
+void FStationGridStorage::Clear(const FIntPoint& Origin, const FIntPoint& Size)
+{
+	ForEachChunkSpan(Origin, Size, [this](const FIntPoint& ChunkCoord, const FIntPoint& First, const FIntPoint& Last)
+	{
+		const int32 ChunkIndex = FindChunk(ChunkCoord);
+		if (ChunkIndex == INDEX_NONE)
+			return false;
+
+		FChunk& Chunk = Chunks[ChunkIndex];
+		const uint32 RowMask = MakeRowMask(First.X & ChunkMask, Last.X - First.X + 1);
+
+		for (int32 Y = First.Y; Y <= Last.Y; ++Y)
+		{
+			const int32 NumCleared = FMath::CountBits(Chunk.OccupiedRows[Y & ChunkMask] & RowMask);
+			Chunk.OccupiedRows[Y & ChunkMask] &= ~RowMask;
+			Chunk.NumOccupied -= NumCleared;
+			NumOccupied -= NumCleared;
+
+			for (int32 X = First.X; X <= Last.X; ++X)
+			{
+				int32& Slot = Chunk.ModuleSlots[ToCellIndex(FIntPoint(X, Y))];
+				if (Slot != EmptySlot && Modules[Slot] != nullptr)
+				{
+					Modules[Slot] = nullptr;
+					FreeSlots.Add(Slot);
+				}
+				Slot = EmptySlot;
+			}
+		}
+		return false;
+	});
+}
+
+void FStationGridStorage::Reset()
+{
+	Chunks.Reset();
+	ChunkTable.Reset();
+	ChunkOrigin = FIntPoint::ZeroValue;
+	ChunkExtent = FIntPoint::ZeroValue;
+	Modules.Reset();
+	FreeSlots.Reset();
+	NumOccupied = 0;
+}
+
+SIZE_T FStationGridStorage::GetAllocatedSize() const
+{
+	return Chunks.GetAllocatedSize() + ChunkTable.GetAllocatedSize() + Modules.GetAllocatedSize() + FreeSlots.GetAllocatedSize();
+}
+
+int32 FStationGridStorage::FindOrAddChunk(const FIntPoint& ChunkCoord)
+{
+	int32 ChunkIndex = FindChunk(ChunkCoord);
+	if (ChunkIndex != INDEX_NONE)
+		return ChunkIndex;
+
+	GrowTable(ChunkCoord);
+
+	const FIntPoint Local = ChunkCoord - ChunkOrigin;
+	ChunkIndex = Chunks.AddDefaulted();
+	ChunkTable[Local.Y * ChunkExtent.X + Local.X] = ChunkIndex;
+	return ChunkIndex;
+}
+
+void FStationGridStorage::GrowTable(const FIntPoint& ChunkCoord)
+{
+	if (ChunkExtent.X == 0 || ChunkExtent.Y == 0)
+	{
+		ChunkOrigin = ChunkCoord;
+		ChunkExtent = FIntPoint(1, 1);
+		ChunkTable.Init(INDEX_NONE, 1);
+		return;
+	}
+
+	const FIntPoint OldMax = ChunkOrigin + ChunkExtent - FIntPoint(1, 1);
+	const FIntPoint NewOrigin(FMath::Min(ChunkOrigin.X, ChunkCoord.X), FMath::Min(ChunkOrigin.Y, ChunkCoord.Y));
+	const FIntPoint NewMax(FMath::Max(OldMax.X, ChunkCoord.X), FMath::Max(OldMax.Y, ChunkCoord.Y));
+	const FIntPoint NewExtent = NewMax - NewOrigin + FIntPoint(1, 1);
+
+	if (NewOrigin == ChunkOrigin && NewExtent == ChunkExtent)
+		return;
+
+	TArray<int32> NewTable;
+	NewTable.Init(INDEX_NONE, NewExtent.X * NewExtent.Y);
+
+	const FIntPoint Shift = ChunkOrigin - NewOrigin;
+	for (int32 Y = 0; Y < ChunkExtent.Y; ++Y)
+	{
+		for (int32 X = 0; X < ChunkExtent.X; ++X)
+		{
+			NewTable[(Y + Shift.Y) * NewExtent.X + (X + Shift.X)] = ChunkTable[Y * ChunkExtent.X + X];
+		}
+	}
+
+	ChunkTable = MoveTemp(NewTable);
+	ChunkOrigin = NewOrigin;
+	ChunkExtent = NewExtent;
+}
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+class AStationModule;
+
+/**
+ * Dense storage for the station grid's cell -> module map.
+ * Cells live in fixed 32x32 chunks and chunks are found through a flat table covering the bounding box
+ * of every chunk in use, so a lookup is a few shifts, masks and two array reads instead of a hash.
+ * The table only grows when a module is placed outside the current bounds.
+ *
+ * Each chunk keeps one 32-bit occupancy mask per row next to the per-cell module slots, so rectangle
+ * and adjacency tests touch one word per row of a footprint rather than one cell at a time.
+ * Cells store a 32-bit slot into a module table instead of a pointer, halving the size of a chunk.
+ */
+class FStationGridStorage
+{
+public:
+
+	static constexpr int32 ChunkShift = 5;
+	static constexpr int32 ChunkSize = 1 << ChunkShift;
+	static constexpr int32 ChunkMask = ChunkSize - 1;
+	static constexpr int32 CellsPerChunk = ChunkSize * ChunkSize;
+
+	/** Returns the module covering the cell, or nullptr */
+	AStationModule* Get(const FIntPoint& Cell) const
+	{
+		const int32 ChunkIndex = FindChunk(ToChunk(Cell));
+		if (ChunkIndex == INDEX_NONE)
+		{
+			return nullptr;
+		}
+
+		const int32 Slot = Chunks[ChunkIndex].ModuleSlots[ToCellIndex(Cell)];
+		return Slot != EmptySlot ? Modules[Slot] : nullptr;
+	}
+
+	bool IsOccupied(const FIntPoint& Cell) const
+	{
+		const int32 ChunkIndex = FindChunk(ToChunk(Cell));
+		return ChunkIndex != INDEX_NONE && (Chunks[ChunkIndex].OccupiedRows[Cell.Y & ChunkMask] & (1u << (Cell.X & ChunkMask))) != 0;
+	}
+
+	/** True if any cell in the Size rectangle starting at Origin is occupied */
+	bool IsRectOccupied(const FIntPoint& Origin, const FIntPoint& Size) const;
+
+	/**
+	 * True if any cell sharing an edge with the rectangle is occupied.
+	 * Cells inside the rectangle are also tested, which only matters if it is not free.
+	 */
+	bool IsRectAdjacentToOccupied(const FIntPoint& Origin, const FIntPoint& Size) const;
+
+	/** Assigns every cell of the rectangle to Module; the cells must be free */
+	void Fill(const FIntPoint& Origin, const FIntPoint& Size, AStationModule* Module);
+
+	/** Frees every cell of a rectangle previously passed to Fill */
+	void Clear(const FIntPoint& Origin, const FIntPoint& Size);
+
+	void Reset();
+
+	/** Bytes held by the chunks, the chunk table and the module table */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Number of occupied cells */
+	int32 Num() const { return NumOccupied; }
+
+private:
+
+	static constexpr int32 EmptySlot = INDEX_NONE;
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FChunk
+	{
+		FChunk();
+
+		/** Bit X of row Y is set when local cell (X, Y) is occupied */
+		TStaticArray<uint32, ChunkSize> OccupiedRows;
+
+		/** Index into Modules for every cell, row-major, or EmptySlot */
+		TStaticArray<int32, CellsPerChunk> ModuleSlots;
+
+		int32 NumOccupied = 0;
+	};
+
+	TArray<FChunk> Chunks;
+
+	/** Chunk index (or INDEX_NONE) for every chunk coordinate in [ChunkOrigin, ChunkOrigin + ChunkExtent), row-major */
+	TArray<int32> ChunkTable;
+	FIntPoint ChunkOrigin = FIntPoint::ZeroValue;
+	FIntPoint ChunkExtent = FIntPoint::ZeroValue;
+
+	/** Modules referenced by cells; freed slots are reused */
+	TArray<AStationModule*> Modules;
+	TArray<int32> FreeSlots;
+
+	int32 NumOccupied = 0;
+
+	/** Arithmetic shifts floor negative coordinates, so chunk -1 covers cells -32..-1 */
+	static int32 ToChunk(int32 Coord) { return Coord >> ChunkShift; }
+	static FIntPoint ToChunk(const FIntPoint& Cell) { return FIntPoint(ToChunk(Cell.X), ToChunk(Cell.Y)); }
+	static int32 ToCellIndex(const FIntPoint& Cell) { return ((Cell.Y & ChunkMask) << ChunkShift) | (Cell.X & ChunkMask); }
+
+	/** Bits [FirstBit, FirstBit + NumBits) of a row mask */
+	static uint32 MakeRowMask(int32 FirstBit, int32 NumBits)
+	{
+		return (NumBits >= ChunkSize ? ~0u : ((1u << NumBits) - 1u)) << FirstBit;
+	}
+
+	int32 FindChunk(const FIntPoint& ChunkCoord) const
+	{
+		const FIntPoint Local = ChunkCoord - ChunkOrigin;
+		if (static_cast<uint32>(Local.X) >= static_cast<uint32>(ChunkExtent.X) || static_cast<uint32>(Local.Y) >= static_cast<uint32>(ChunkExtent.Y))
+		{
+			return INDEX_NONE;
+		}
+		return ChunkTable[Local.Y * ChunkExtent.X + Local.X];
+	}
+
+	int32 FindOrAddChunk(const FIntPoint& ChunkCoord);
+
+	/** Re-lays the chunk table so it also covers ChunkCoord */
+	void GrowTable(const FIntPoint& ChunkCoord);
+
+	/**
+	 * Calls Func(ChunkCoord, FirstCell, LastCell) for every chunk the rectangle overlaps,
+	 * with the inclusive part of the rectangle inside that chunk in world cells.
+	 */
+	template<typename FunctorType>
+	static bool ForEachChunkSpan(const FIntPoint& Origin, const FIntPoint& Size, FunctorType&& Func);
+};
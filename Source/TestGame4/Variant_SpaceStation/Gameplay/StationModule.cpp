@@ -3,6 +3,7 @@
 #include "StationModule.h"
 #include "StationGrid.h"
 #include "SpaceStationGameMode.h"
+#include "StationSystemsComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
@@ -87,6 +88,15 @@ void AStationModule::SetPoweredState(bool bPowered)
 	BP_PowerStateChanged(bPowered);
 }
 
+void AStationModule::NotifySystemStatsChanged()
+{
+	ASpaceStationGameMode* GM = Cast<ASpaceStationGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+	if (GM && GM->GetStationSystems())
+	{
+		GM->GetStationSystems()->OnModuleStatsChanged(this);
+	}
+}
+
 bool AStationModule::CanConnectTo(AStationModule* Other) const
 {
 	if (!Other)
@@ -26,6 +26,9 @@ enum class EStationModuleType : uint8
 	Custom          // Custom/other
 };
 
+/** Number of EStationModuleType values, for arrays indexed by module type */
+static constexpr int32 NumStationModuleTypes = static_cast<int32>(EStationModuleType::Custom) + 1;
+
 /**
  * Base class for all placeable station modules (rooms, corridors, etc.).
  * Handles grid placement, connectivity, power/atmosphere, and visual feedback.
@@ -153,6 +156,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Module")
 	void SetPoweredState(bool bPowered);
 
+	/** Call after changing power or oxygen stats at runtime so the station totals pick up the change */
+	UFUNCTION(BlueprintCallable, Category="Systems")
+	void NotifySystemStatsChanged();
+
 	/** Connectivity */
 
 	/** Check if this module can connect to another */
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationModuleRegistry.h"
+
+bool FStationModuleRegistry::Add(AStationModule* Module)
+{
+	if (!Module || Slots.Contains(Module))
+		return false;
+
+	TArray<AStationModule*>& Bucket = ModulesByType[static_cast<int32>(Module->ModuleType)];
+
+	FSlot& Slot = Slots.Add(Module);
+	Slot.AllIndex = AllModules.Add(Module);
+	Slot.TypeIndex = Bucket.Add(Module);
+	Slot.ModuleType = Module->ModuleType;
+	return true;
+}
+
+void FStationModuleRegistry::Reset()
+{
+	AllModules.Reset();
+	for (TArray<AStationModule*>& Bucket : ModulesByType)
+	{
+		Bucket.Reset();
+	}
+	Slots.Reset();
+}
+
+bool FStationModuleRegistry::Remove(AStationModule* Module)
+{
+	FSlot Slot;
+	if (!Module || !Slots.RemoveAndCopyValue(Module, Slot))
+		return false;
+
+	// Swap-remove from both lists and patch the slot of whichever module moved into the gap
+	AllModules.RemoveAtSwap(Slot.AllIndex, EAllowShrinking::No);
+	if (AllModules.IsValidIndex(Slot.AllIndex))
+	{
+		Slots.FindChecked(AllModules[Slot.AllIndex]).AllIndex = Slot.AllIndex;
+	}
+
+	TArray<AStationModule*>& Bucket = ModulesByType[static_cast<int32>(Slot.ModuleType)];
+	Bucket.RemoveAtSwap(Slot.TypeIndex, EAllowShrinking::No);
+	if (Bucket.IsValidIndex(Slot.TypeIndex))
+	{
+		Slots.FindChecked(Bucket[Slot.TypeIndex]).TypeIndex = Slot.TypeIndex;
+	}
+
+	return true;
+}
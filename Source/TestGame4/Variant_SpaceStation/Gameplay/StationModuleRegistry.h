@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "StationModule.h"
+
+/**
+ * Registry of placed station modules.
+ * Keeps one flat list plus one list per module type, all updated in O(1) on add and remove,
+ * so consumers can iterate a const view instead of copying or filtering the whole station.
+ * Views are invalidated by the next Add or Remove; removal does not preserve order.
+ */
+class FStationModuleRegistry
+{
+public:
+
+	/** Adds a module; returns false if it was already registered */
+	bool Add(AStationModule* Module);
+
+	/** Removes a module; returns false if it was not registered */
+	bool Remove(AStationModule* Module);
+
+	bool Contains(const AStationModule* Module) const { return Slots.Contains(Module); }
+
+	void Reset();
+
+	int32 Num() const { return AllModules.Num(); }
+
+	/** All registered modules */
+	const TArray<AStationModule*>& GetAll() const { return AllModules; }
+
+	/** Registered modules of one type, bucketed by the type they had when registered */
+	TConstArrayView<AStationModule*> GetByType(EStationModuleType ModuleType) const { return ModulesByType[static_cast<int32>(ModuleType)]; }
+
+private:
+
+	/** Where a module sits in the flat list and in its type bucket */
+	struct FSlot
+	{
+		int32 AllIndex = INDEX_NONE;
+		int32 TypeIndex = INDEX_NONE;
+		EStationModuleType ModuleType = EStationModuleType::Corridor;
+	};
+
+	TArray<AStationModule*> AllModules;
+	TStaticArray<TArray<AStationModule*>, NumStationModuleTypes> ModulesByType;
+	TMap<const AStationModule*, FSlot> Slots;
+};
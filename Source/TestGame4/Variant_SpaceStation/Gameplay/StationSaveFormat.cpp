@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationSaveFormat.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "TestGame4.h"
+
+namespace
+{
+	/** Pads Buffer to the section alignment and appends Num elements, returning where they start */
+	template<typename T>
+	uint64 AppendSection(TArray<uint8>& Buffer, const T* Elements, int32 Num)
+	{
+		const int32 Padding = static_cast<int32>(Align(static_cast<uint64>(Buffer.Num()), StationSaveFormat::SectionAlignment) - Buffer.Num());
+		Buffer.AddZeroed(Padding);
+
+		const uint64 Offset = Buffer.Num();
+		Buffer.Append(reinterpret_cast<const uint8*>(Elements), Num * static_cast<int32>(sizeof(T)));
+		return Offset;
+	}
+
+	/** Points OutView at Num elements at Offset, if they lie entirely inside the file and are aligned */
+	template<typename T>
+	bool GetSection(const uint8* Data, int64 Size, uint64 Offset, uint64 Num, TConstArrayView<T>& OutView)
+	{
+		if (Offset % alignof(T) != 0 || Offset > static_cast<uint64>(Size) || Num > MAX_int32
+			|| Num > (static_cast<uint64>(Size) - Offset) / sizeof(T))
+		{
+			return false;
+		}
+
+		OutView = MakeArrayView(reinterpret_cast<const T*>(Data + Offset), static_cast<int32>(Num));
+		return true;
+	}
+}
+
+bool WriteStationSaveFile(const FString& Filename, const FStationSaveView& Data)
+{
+	const int32 NumModules = Data.ModuleClasses.Num();
+	const int32 NumCrew = Data.CrewLocations.Num();
+	if (Data.ModulePositions.Num() != NumModules || Data.ModuleRotations.Num() != NumModules
+		|| Data.CrewNeeds.Num() != NumCrew || Data.CrewAlive.Num() != NumCrew
+		|| Data.ClassPaths.Num() > MAX_uint16 + 1)
+	{
+		return false;
+	}
+
+	TArray<uint32> ClassNameOffsets;
+	TArray<uint8> ClassNames;
+	ClassNameOffsets.Reserve(Data.ClassPaths.Num() + 1);
+	for (const FString& ClassPath : Data.ClassPaths)
+	{
+		FTCHARToUTF8 Utf8(*ClassPath);
+		ClassNameOffsets.Add(ClassNames.Num());
+		ClassNames.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+	ClassNameOffsets.Add(ClassNames.Num());
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(sizeof(FStationSaveHeader) + ClassNames.Num() + NumModules * 16 + NumCrew * 40 + 64);
+	Buffer.AddZeroed(sizeof(FStationSaveHeader));
+
+	FStationSaveHeader Header;
+	Header.Magic = StationSaveFormat::Magic;
+	Header.Version = StationSaveFormat::Version;
+	Header.Credits = Data.Credits;
+	Header.Food = Data.Food;
+	Header.NumClasses = Data.ClassPaths.Num();
+	Header.NumModules = NumModules;
+	Header.NumCrew = NumCrew;
+
+	Header.ClassNameOffsetsOffset = AppendSection(Buffer, ClassNameOffsets.GetData(), ClassNameOffsets.Num());
+	Header.ClassNamesOffset = AppendSection(Buffer, ClassNames.GetData(), ClassNames.Num());
+	Header.ModuleClassesOffset = AppendSection(Buffer, Data.ModuleClasses.GetData(), NumModules);
+	Header.ModulePositionsOffset = AppendSection(Buffer, Data.ModulePositions.GetData(), NumModules);
+	Header.ModuleRotationsOffset = AppendSection(Buffer, Data.ModuleRotations.GetData(), NumModules);
+	Header.CrewLocationsOffset = AppendSection(Buffer, Data.CrewLocations.GetData(), NumCrew);
+	Header.CrewNeedsOffset = AppendSection(Buffer, Data.CrewNeeds.GetData(), NumCrew);
+	Header.CrewAliveOffset = AppendSection(Buffer, Data.CrewAlive.GetData(), NumCrew);
+	Header.FileSize = Buffer.Num();
+
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(Header));
+
+	return FFileHelper::SaveArrayToFile(Buffer, *Filename);
+}
+
+FStationSaveReader::FStationSaveReader() = default;
+
+FStationSaveReader::~FStationSaveReader()
+{
+	// The region must be unmapped before its file handle closes
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FStationSaveReader::Open(const FString& Filename)
+{
+	View = FStationSaveView();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FileData.Reset();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Filename);
+	if (MappedResult.HasValue())
+	{
+		MappedFile = MappedResult.StealValue();
+		const int64 Size = MappedFile->GetFileSize();
+		if (Size > 0)
+		{
+			MappedRegion.Reset(MappedFile->MapRegion(0, Size));
+		}
+	}
+
+	if (MappedRegion)
+	{
+		return Parse(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	}
+
+	MappedFile.Reset();
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent))
+		return false;
+
+	return Parse(FileData.GetData(), FileData.Num());
+}
+
+bool FStationSaveReader::Parse(const uint8* Data, int64 Size)
+{
+	if (!Data || Size < static_cast<int64>(sizeof(FStationSaveHeader)))
+		return false;
+
+	FStationSaveHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+	if (Header.Magic != StationSaveFormat::Magic)
+		return false;
+
+	if (Header.Version != StationSaveFormat::Version)
+	{
+		UE_LOG(LogTestGame4, Warning, TEXT("Station save has version %u, expected %u."), Header.Version, StationSaveFormat::Version);
+		return false;
+	}
+
+	if (Header.FileSize != static_cast<uint64>(Size))
+		return false;
+
+	TConstArrayView<uint32> ClassNameOffsets;
+	TConstArrayView<uint8> ClassNames;
+	if (!GetSection(Data, Size, Header.ClassNameOffsetsOffset, static_cast<uint64>(Header.NumClasses) + 1, ClassNameOffsets)
+		|| !GetSection(Data, Size, Header.ClassNamesOffset, ClassNameOffsets.Last(), ClassNames))
+	{
+		return false;
+	}
+
+	FStationSaveView Parsed;
+	Parsed.Credits = Header.Credits;
+	Parsed.Food = Header.Food;
+
+	if (!GetSection(Data, Size, Header.ModuleClassesOffset, Header.NumModules, Parsed.ModuleClasses)
+		|| !GetSection(Data, Size, Header.ModulePositionsOffset, Header.NumModules, Parsed.ModulePositions)
+		|| !GetSection(Data, Size, Header.ModuleRotationsOffset, Header.NumModules, Parsed.ModuleRotations)
+		|| !GetSection(Data, Size, Header.CrewLocationsOffset, Header.NumCrew, Parsed.CrewLocations)
+		|| !GetSection(Data, Size, Header.CrewNeedsOffset, Header.NumCrew, Parsed.CrewNeeds)
+		|| !GetSection(Data, Size, Header.CrewAliveOffset, Header.NumCrew, Parsed.CrewAlive))
+	{
+		return false;
+	}
+
+	// The class table is tiny, so it is the one section decoded rather than read in place
+	Parsed.ClassPaths.Reserve(Header.NumClasses);
+	for (uint32 ClassIndex = 0; ClassIndex < Header.NumClasses; ++ClassIndex)
+	{
+		const uint32 Begin = ClassNameOffsets[ClassIndex];
+		const uint32 End = ClassNameOffsets[ClassIndex + 1];
+		if (Begin > End || End > static_cast<uint32>(ClassNames.Num()))
+			return false;
+
+		FUTF8ToTCHAR ClassPath(reinterpret_cast<const ANSICHAR*>(ClassNames.GetData() + Begin), End - Begin);
+		Parsed.ClassPaths.Emplace(ClassPath.Length(), ClassPath.Get());
+	}
+
+	View = MoveTemp(Parsed);
+	return true;
+}
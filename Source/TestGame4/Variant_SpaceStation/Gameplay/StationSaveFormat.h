@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace StationSaveFormat
+{
+	/** 'STSV' */
+	static constexpr uint32 Magic = 0x56535453;
+
+	/** Bump when the layout changes; older files are rejected rather than misread */
+	static constexpr uint32 Version = 1;
+
+	/** Every section starts on this boundary so arrays can be read in place */
+	static constexpr uint64 SectionAlignment = 8;
+}
+
+/**
+ * Fixed header at the start of a station save.
+ * The rest of the file is one flat array per field, located by the offsets below (bytes from the start of the file).
+ * Values are stored in native little-endian layout.
+ */
+struct FStationSaveHeader
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint64 FileSize = 0;
+
+	int32 Credits = 0;
+	int32 Food = 0;
+
+	uint32 NumClasses = 0;
+	uint32 NumModules = 0;
+	uint32 NumCrew = 0;
+	uint32 Padding = 0;
+
+	/** uint32[NumClasses + 1], byte ranges of each class path in ClassNames */
+	uint64 ClassNameOffsetsOffset = 0;
+
+	/** UTF-8 class paths, back to back without terminators */
+	uint64 ClassNamesOffset = 0;
+
+	/** uint16[NumModules], index into the class table */
+	uint64 ModuleClassesOffset = 0;
+
+	/** FIntPoint[NumModules] */
+	uint64 ModulePositionsOffset = 0;
+
+	/** uint8[NumModules], yaw in quarter turns */
+	uint64 ModuleRotationsOffset = 0;
+
+	/** FVector3f[NumCrew] */
+	uint64 CrewLocationsOffset = 0;
+
+	/** FVector4f[NumCrew]: oxygen, food, sleep, health */
+	uint64 CrewNeedsOffset = 0;
+
+	/** uint8[NumCrew], 1 if alive */
+	uint64 CrewAliveOffset = 0;
+};
+
+/**
+ * Contents of a station save as flat arrays.
+ * Filled from live arrays when saving, or pointing straight into the mapped file when loading.
+ */
+struct FStationSaveView
+{
+	int32 Credits = 0;
+	int32 Food = 0;
+
+	/** Soft class path of every module class used, indexed by ModuleClasses */
+	TArray<FString> ClassPaths;
+
+	TConstArrayView<uint16> ModuleClasses;
+	TConstArrayView<FIntPoint> ModulePositions;
+	TConstArrayView<uint8> ModuleRotations;
+
+	TConstArrayView<FVector3f> CrewLocations;
+	TConstArrayView<FVector4f> CrewNeeds;
+	TConstArrayView<uint8> CrewAlive;
+};
+
+/** Writes Data to Filename in the station save format; returns false if the arrays disagree in length or the write fails */
+bool WriteStationSaveFile(const FString& Filename, const FStationSaveView& Data);
+
+/**
+ * Reads a station save by memory-mapping it (falling back to a plain read where mapping is unavailable).
+ * Validates the header and every section's bounds, then exposes the arrays in place without copying.
+ * The view is only valid while the reader is alive.
+ */
+class FStationSaveReader
+{
+public:
+
+	FStationSaveReader();
+	~FStationSaveReader();
+
+	/** Returns false if the file is missing, truncated, or of another format or version */
+	bool Open(const FString& Filename);
+
+	const FStationSaveView& GetView() const { return View; }
+
+private:
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Used instead of the mapping when the platform cannot map the file */
+	TArray<uint8> FileData;
+
+	FStationSaveView View;
+
+	bool Parse(const uint8* Data, int64 Size);
+};
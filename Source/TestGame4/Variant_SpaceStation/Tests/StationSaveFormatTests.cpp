@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StationSaveFormat.h"
+#include "Algo/Compare.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace StationSaveFormatTests
+{
+	/** Small but complete station: two classes, a few modules of each, living and dead crew */
+	struct FSampleStation
+	{
+		TArray<FString> ClassPaths = { TEXT("/Game/SpaceStation/BP_Corridor.BP_Corridor_C"), TEXT("/Game/SpaceStation/BP_LifeSupport.BP_LifeSupport_C") };
+		TArray<uint16> ModuleClasses = { 0, 0, 1, 0, 1 };
+		TArray<FIntPoint> ModulePositions = { FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(2, 0), FIntPoint(-1, 0), FIntPoint(0, -3) };
+		TArray<uint8> ModuleRotations = { 0, 1, 2, 3, 0 };
+		TArray<FVector3f> CrewLocations = { FVector3f(10.0f, 20.0f, 30.0f), FVector3f(-400.0f, 0.5f, 88.0f) };
+		TArray<FVector4f> CrewNeeds = { FVector4f(90.0f, 80.0f, 70.0f, 100.0f), FVector4f(0.0f, 12.5f, 3.0f, 0.0f) };
+		TArray<uint8> CrewAlive = { 1, 0 };
+
+		FStationSaveView MakeView() const
+		{
+			FStationSaveView View;
+			View.Credits = 1234;
+			View.Food = -5;
+			View.ClassPaths = ClassPaths;
+			View.ModuleClasses = ModuleClasses;
+			View.ModulePositions = ModulePositions;
+			View.ModuleRotations = ModuleRotations;
+			View.CrewLocations = CrewLocations;
+			View.CrewNeeds = CrewNeeds;
+			View.CrewAlive = CrewAlive;
+			return View;
+		}
+	};
+
+	template<typename T>
+	static bool SectionsEqual(TConstArrayView<T> A, TConstArrayView<T> B)
+	{
+		return A.Num() == B.Num() && Algo::Compare(A, B);
+	}
+
+	static FString GetTestFilename(const TCHAR* Name)
+	{
+		return FPaths::AutomationTransientDir() / TEXT("StationSaveFormat") / (FString(Name) + TEXT(".station"));
+	}
+
+	/** Writes the sample station and returns the file's bytes */
+	static bool WriteSample(FAutomationTestBase& Test, const FString& Filename, TArray<uint8>& OutBytes)
+	{
+		const FSampleStation Sample;
+		if (!Test.TestTrue(TEXT("Sample station is written"), WriteStationSaveFile(Filename, Sample.MakeView())))
+			return false;
+
+		const bool bLoaded = FFileHelper::LoadFileToArray(OutBytes, *Filename);
+		IFileManager::Get().Delete(*Filename);
+		return Test.TestTrue(TEXT("Sample station is read back as bytes"), bLoaded);
+	}
+
+	static FStationSaveHeader ReadHeader(const TArray<uint8>& Bytes)
+	{
+		FStationSaveHeader Header;
+		FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+		return Header;
+	}
+
+	static void WriteHeader(TArray<uint8>& Bytes, const FStationSaveHeader& Header)
+	{
+		FMemory::Memcpy(Bytes.GetData(), &Header, sizeof(Header));
+	}
+
+	/** Saves Bytes under Name and reports whether the reader accepts them */
+	static bool OpenBytes(const TCHAR* Name, const TArray<uint8>& Bytes)
+	{
+		const FString Filename = GetTestFilename(Name);
+		FFileHelper::SaveArrayToFile(Bytes, *Filename);
+
+		bool bOpened = false;
+		{
+			FStationSaveReader Reader;
+			bOpened = Reader.Open(Filename);
+		}
+
+		IFileManager::Get().Delete(*Filename);
+		return bOpened;
+	}
+
+	/** Applies Patch to a copy of the sample's header and reports whether the reader still accepts the file */
+	template<typename PatchType>
+	static bool OpenPatched(const TCHAR* Name, const TArray<uint8>& Bytes, PatchType&& Patch)
+	{
+		TArray<uint8> Patched = Bytes;
+		FStationSaveHeader Header = ReadHeader(Patched);
+		Patch(Header);
+		WriteHeader(Patched, Header);
+		return OpenBytes(Name, Patched);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStationSaveRoundTripTest, "TestGame4.SpaceStation.SaveFormat.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStationSaveRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace StationSaveFormatTests;
+
+	const FSampleStation Sample;
+	const FStationSaveView Expected = Sample.MakeView();
+	const FString Filename = GetTestFilename(TEXT("RoundTrip"));
+
+	if (!TestTrue(TEXT("Write succeeds"), WriteStationSaveFile(Filename, Expected)))
+		return false;
+
+	{
+		FStationSaveReader Reader;
+		if (!TestTrue(TEXT("Read succeeds"), Reader.Open(Filename)))
+			return false;
+
+		const FStationSaveView& Actual = Reader.GetView();
+		TestEqual(TEXT("Credits"), Actual.Credits, Expected.Credits);
+		TestEqual(TEXT("Food"), Actual.Food, Expected.Food);
+		TestTrue(TEXT("Class paths"), Actual.ClassPaths == Expected.ClassPaths);
+		TestTrue(TEXT("Module classes"), SectionsEqual(Actual.ModuleClasses, Expected.ModuleClasses));
+		TestTrue(TEXT("Module positions"), SectionsEqual(Actual.ModulePositions, Expected.ModulePositions));
+		TestTrue(TEXT("Module rotations"), SectionsEqual(Actual.ModuleRotations, Expected.ModuleRotations));
+		TestTrue(TEXT("Crew locations"), SectionsEqual(Actual.CrewLocations, Expected.CrewLocations));
+		TestTrue(TEXT("Crew needs"), SectionsEqual(Actual.CrewNeeds, Expected.CrewNeeds));
+		TestTrue(TEXT("Crew alive"), SectionsEqual(Actual.CrewAlive, Expected.CrewAlive));
+	}
+
+	// An empty station is a valid save too
+	const FStationSaveView Empty;
+	TestTrue(TEXT("Empty write succeeds"), WriteStationSaveFile(Filename, Empty));
+	{
+		FStationSaveReader Reader;
+		if (TestTrue(TEXT("Empty read succeeds"), Reader.Open(Filename)))
+		{
+			TestEqual(TEXT("Empty has no classes"), Reader.GetView().ClassPaths.Num(), 0);
+			TestEqual(TEXT("Empty has no modules"), Reader.GetView().ModuleClasses.Num(), 0);
+			TestEqual(TEXT("Empty has no crew"), Reader.GetView().CrewLocations.Num(), 0);
+		}
+	}
+
+	// Arrays that disagree in length are refused rather than written
+	FStationSaveView Mismatched = Expected;
+	Mismatched.ModuleRotations = Mismatched.ModuleRotations.LeftChop(1);
+	TestFalse(TEXT("Mismatched section lengths are not written"), WriteStationSaveFile(GetTestFilename(TEXT("Mismatched")), Mismatched));
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStationSaveRejectsHeaderTest, "TestGame4.SpaceStation.SaveFormat.RejectsBadHeader", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStationSaveRejectsHeaderTest::RunTest(const FString& Parameters)
+{
+	using namespace StationSaveFormatTests;
+
+	TArray<uint8> Bytes;
+	if (!WriteSample(*this, GetTestFilename(TEXT("HeaderSource")), Bytes))
+		return false;
+
+	TestTrue(TEXT("Unmodified sample opens"), OpenBytes(TEXT("Unmodified"), Bytes));
+
+	TestFalse(TEXT("Bad magic"), OpenPatched(TEXT("BadMagic"), Bytes, [](FStationSaveHeader& Header) { Header.Magic ^= 0xFF; }));
+
+	AddExpectedMessage(TEXT("Station save has version"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 2);
+	TestFalse(TEXT("Newer version"), OpenPatched(TEXT("NewerVersion"), Bytes, [](FStationSaveHeader& Header) { Header.Version = StationSaveFormat::Version + 1; }));
+	TestFalse(TEXT("Zero version"), OpenPatched(TEXT("ZeroVersion"), Bytes, [](FStationSaveHeader& Header) { Header.Version = 0; }));
+
+	TestFalse(TEXT("Missing file"), FStationSaveReader().Open(GetTestFilename(TEXT("DoesNotExist"))));
+	TestFalse(TEXT("Empty file"), OpenBytes(TEXT("EmptyFile"), TArray<uint8>()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStationSaveRejectsTruncatedTest, "TestGame4.SpaceStation.SaveFormat.RejectsTruncated", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStationSaveRejectsTruncatedTest::RunTest(const FString& Parameters)
+{
+	using namespace StationSaveFormatTests;
+
+	TArray<uint8> Bytes;
+	if (!WriteSample(*this, GetTestFilename(TEXT("TruncatedSource")), Bytes))
+		return false;
+
+	// Cut inside the header
+	TArray<uint8> HeaderOnly(Bytes.GetData(), sizeof(FStationSaveHeader) / 2);
+	TestFalse(TEXT("Truncated inside the header"), OpenBytes(TEXT("TruncatedHeader"), HeaderOnly));
+
+	// Cut inside the last section, leaving the recorded size stale
+	TArray<uint8> Truncated(Bytes.GetData(), Bytes.Num() - 1);
+	TestFalse(TEXT("Truncated with stale file size"), OpenBytes(TEXT("TruncatedStale"), Truncated));
+
+	// Same cut but with the recorded size patched to match, so only the section bounds checks can catch it
+	FStationSaveHeader Header = ReadHeader(Truncated);
+	Header.FileSize = Truncated.Num();
+	WriteHeader(Truncated, Header);
+	TestFalse(TEXT("Truncated with matching file size"), OpenBytes(TEXT("TruncatedMatching"), Truncated));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStationSaveRejectsOutOfRangeTest, "TestGame4.SpaceStation.SaveFormat.RejectsOutOfRange", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStationSaveRejectsOutOfRangeTest::RunTest(const FString& Parameters)
+{
+	using namespace StationSaveFormatTests;
+
+	TArray<uint8> Bytes;
+	if (!WriteSample(*this, GetTestFilename(TEXT("RangeSource")), Bytes))
+		return false;
+
+	const uint64 FileSize = Bytes.Num();
+
+	// Offsets past the end of the file
+	TestFalse(TEXT("Module positions past the end"), OpenPatched(TEXT("PositionsPastEnd"), Bytes, [FileSize](FStationSaveHeader& Header) { Header.ModulePositionsOffset = FileSize; }));
+	TestFalse(TEXT("Crew needs far past the end"), OpenPatched(TEXT("NeedsFarPastEnd"), Bytes, [](FStationSaveHeader& Header) { Header.CrewNeedsOffset = MAX_uint64 - 7; }));
+	TestFalse(TEXT("Class names past the end"), OpenPatched(TEXT("NamesPastEnd"), Bytes, [FileSize](FStationSaveHeader& Header) { Header.ClassNamesOffset = FileSize + 8; }));
+
+	// Misaligned offsets
+	TestFalse(TEXT("Misaligned module positions"), OpenPatched(TEXT("MisalignedPositions"), Bytes, [](FStationSaveHeader& Header) { Header.ModulePositionsOffset += 1; }));
+	TestFalse(TEXT("Misaligned class name offsets"), OpenPatched(TEXT("MisalignedNameOffsets"), Bytes, [](FStationSaveHeader& Header) { Header.ClassNameOffsetsOffset += 2; }));
+
+	// Counts larger than the file can hold
+	TestFalse(TEXT("Module count too large"), OpenPatched(TEXT("ModuleCount"), Bytes, [](FStationSaveHeader& Header) { Header.NumModules = MAX_uint32; }));
+	TestFalse(TEXT("Crew count too large"), OpenPatched(TEXT("CrewCount"), Bytes, [](FStationSaveHeader& Header) { Header.NumCrew += 1000; }));
+	TestFalse(TEXT("Class count too large"), OpenPatched(TEXT("ClassCount"), Bytes, [](FStationSaveHeader& Header) { Header.NumClasses = MAX_uint32; }));
+
+	// Class name ranges that run backwards or past the name blob
+	{
+		const FStationSaveHeader Header = ReadHeader(Bytes);
+
+		TArray<uint8> Backwards = Bytes;
+		uint32* NameOffsets = reinterpret_cast<uint32*>(Backwards.GetData() + Header.ClassNameOffsetsOffset);
+		Swap(NameOffsets[0], NameOffsets[1]);
+		TestFalse(TEXT("Class name range runs backwards"), OpenBytes(TEXT("NamesBackwards"), Backwards));
+
+		// The blob is sized by the last offset, so an inner offset beyond it must be caught per class
+		TArray<uint8> PastBlob = Bytes;
+		NameOffsets = reinterpret_cast<uint32*>(PastBlob.GetData() + Header.ClassNameOffsetsOffset);
+		NameOffsets[1] = NameOffsets[Header.NumClasses] + 1;
+		TestFalse(TEXT("Class name range past the blob"), OpenBytes(TEXT("NamesPastBlob"), PastBlob));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -8,6 +8,9 @@
 #include "Blueprint/UserWidget.h"
 #include "Engine/Canvas.h"
 #include "Kismet/GameplayStatics.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_StationHUDDraw, STATGROUP_SpaceStation);
 
 ASpaceStationHUD::ASpaceStationHUD()
 {
@@ -22,6 +25,8 @@ void ASpaceStationHUD::BeginPlay()
 
 void ASpaceStationHUD::DrawHUD()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StationHUDDraw);
+
 	Super::DrawHUD();
 
 	DrawCrewSelection();
@@ -16,6 +16,11 @@
 #include "StrategyUnit.h"
 #include "NavigationSystem.h"
 #include "Engine/OverlapResult.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Selection Command"), STAT_StrategySelectionCommand, STATGROUP_Strategy);
+DECLARE_CYCLE_STAT(TEXT("Drag Select"), STAT_StrategyDragSelect, STATGROUP_Strategy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traces"), STAT_StrategyTraces, STATGROUP_Strategy);
 
 AStrategyPlayerController::AStrategyPlayerController()
 {
@@ -107,6 +112,8 @@ void AStrategyPlayerController::OnPossess(APawn* InPawn)
 
 void AStrategyPlayerController::DragSelectUnits(const TArray<AStrategyUnit*>& Units)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StrategyDragSelect);
+
 	// do we have units in the list?
 	if (Units.Num() > 0)
 	{
@@ -400,6 +407,7 @@ void AStrategyPlayerController::TouchSecondaryCompleted(const FInputActionValue&
 
 void AStrategyPlayerController::DoSelectionCommand()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StrategySelectionCommand);
 
 	// do a sphere sweep to look for actors to select
 	FHitResult OutHit;
@@ -418,6 +426,7 @@ void AStrategyPlayerController::DoSelectionCommand()
 	QueryParams.AddIgnoredActor(GetPawn());
 	QueryParams.bTraceComplex = true;
 
+	INC_DWORD_STAT(STAT_StrategyTraces);
 	GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, InteractionSphere, QueryParams);
 
 	// if we're using the mouse and are not holding the selection modifier key, deselect any units first
@@ -660,6 +669,7 @@ void AStrategyPlayerController::OnMoveCompleted(AStrategyUnit* MovedUnit)
 				QueryParams.AddIgnoredActor(CurSelected);
 			}
 
+			INC_DWORD_STAT(STAT_StrategyTraces);
 			if (GetWorld()->OverlapMultiByObjectType(OutOverlaps, CachedInteraction, FQuat::Identity, ObjectParams, CollisionSphere, QueryParams))
 			{
 				for (const FOverlapResult& CurrentOverlap : OutOverlaps)
@@ -736,6 +746,7 @@ bool AStrategyPlayerController::GetLocationUnderCursor(FVector& Location)
 	// trace the visibility channel at the cursor location
 	FHitResult OutHit;
 
+	INC_DWORD_STAT(STAT_StrategyTraces);
 	GetHitResultUnderCursorByChannel(SelectionTraceChannel, true, OutHit);
 
 	// if there was a blocking hit, return the hit location
@@ -5,6 +5,9 @@
 #include "StrategyUnit.h"
 #include "StrategyPlayerController.h"
 #include "StrategyUI.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_StrategyHUDDraw, STATGROUP_Strategy);
 
 void AStrategyHUD::BeginPlay()
 {
@@ -30,6 +33,8 @@ void AStrategyHUD::DragSelectUpdate(FVector2D Start, FVector2D WidthAndHeight, F
 
 void AStrategyHUD::DrawHUD()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_StrategyHUDDraw);
+
 	// draw all debug information, etc.
 	Super::DrawHUD();
 
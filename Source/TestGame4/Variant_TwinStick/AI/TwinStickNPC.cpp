@@ -11,6 +11,7 @@
 #include "Engine/World.h"
 #include "TwinStickNPCDestruction.h"
 #include "TimerManager.h"
+#include "TestGame4Stats.h"
 
 ATwinStickNPC::ATwinStickNPC()
 {
@@ -103,10 +104,12 @@ void ATwinStickNPC::ProjectileImpact(const FVector& ForwardVector)
 	// randomly spawn a pickup
 	if (FMath::RandRange(0, 100) < PickupSpawnChance)
 	{
+		INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 		ATwinStickPickup* Pickup = GetWorld()->SpawnActor<ATwinStickPickup>(PickupClass, GetActorTransform());
 	}
 	
 	// spawn the NPC destruction proxy
+	INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 	ATwinStickNPCDestruction* DestructionProxy = GetWorld()->SpawnActor<ATwinStickNPCDestruction>(DestructionProxyClass, GetActorTransform());
 
 	// hide this actor
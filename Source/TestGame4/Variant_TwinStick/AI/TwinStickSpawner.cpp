@@ -9,6 +9,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "TwinStickNPC.h"
 #include "TwinStickGameMode.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn NPC Group"), STAT_TwinStickSpawnNPCGroup, STATGROUP_TwinStick);
 
 ATwinStickSpawner::ATwinStickSpawner()
 {
@@ -51,6 +54,8 @@ void ATwinStickSpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 void ATwinStickSpawner::SpawnNPCGroup()
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_TwinStickSpawnNPCGroup);
+
 	// reset the group spawn counter
 	SpawnCount = 0;
 
@@ -75,6 +80,7 @@ void ATwinStickSpawner::SpawnNPC()
 		SpawnTransform.SetLocation(SpawnLoc);
 
 		// spawn the NPC
+		INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 		ATwinStickNPC* NPC = GetWorld()->SpawnActor<ATwinStickNPC>(NPCClass, SpawnTransform);
 	}
 
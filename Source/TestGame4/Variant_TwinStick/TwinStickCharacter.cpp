@@ -13,6 +13,9 @@
 #include "TwinStickProjectile.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "TestGame4Stats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Tick"), STAT_TwinStickCharacterTick, STATGROUP_TwinStick);
 
 ATwinStickCharacter::ATwinStickCharacter()
 {
@@ -72,6 +75,8 @@ void ATwinStickCharacter::NotifyControllerChanged()
 
 void ATwinStickCharacter::Tick(float DeltaTime)
 {
+	TESTGAME4_SCOPE_CYCLE_COUNTER(STAT_TwinStickCharacterTick);
+
 	Super::Tick(DeltaTime);
 
 	// get the current rotation
@@ -242,6 +247,7 @@ void ATwinStickCharacter::DoShoot()
 	FVector ProjectileLocation = ProjectileTransform.GetLocation() + ProjectileTransform.GetRotation().RotateVector(FVector::ForwardVector * ProjectileOffset);
 	ProjectileTransform.SetLocation(ProjectileLocation);
 
+	INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 	ATwinStickProjectile* Projectile = GetWorld()->SpawnActor<ATwinStickProjectile>(ProjectileClass, ProjectileTransform);
 }
 
@@ -260,6 +266,7 @@ void ATwinStickCharacter::DoAoEAttack()
 			LastAoETime = GameTime;
 
 			// spawn the AoE
+			INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 			ATwinStickAoEAttack* AoE = GetWorld()->SpawnActor<ATwinStickAoEAttack>(AoEAttackClass, GetActorTransform());
 
 			// decrease the number of items
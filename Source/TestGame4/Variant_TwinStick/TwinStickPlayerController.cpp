@@ -12,6 +12,7 @@
 #include "Blueprint/UserWidget.h"
 #include "TestGame4.h"
 #include "Widgets/Input/SVirtualJoystick.h"
+#include "TestGame4Stats.h"
 
 void ATwinStickPlayerController::BeginPlay()
 {
@@ -83,6 +84,7 @@ void ATwinStickPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 		// spawn a character at the player start
 		const FTransform SpawnTransform = ActorList[0]->GetActorTransform();
 
+		INC_DWORD_STAT(STAT_TwinStickActorsSpawned);
 		if (ATwinStickCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ATwinStickCharacter>(CharacterClass, SpawnTransform))
 		{
 			// possess the character